@@ -168,8 +168,8 @@ ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last, BP op
 }
 
 template <typename ForwardIterator, typename T>
-typename iterator_traits<ForwardIterator>::difference_type
-count(ForwardIterator first, ForwardIterator last, T value) {
+static typename iterator_traits<ForwardIterator>::difference_type
+__count(ForwardIterator first, ForwardIterator last, const T &value, false_type) {
 	typename iterator_traits<ForwardIterator>::difference_type n = 0;
 	for(;first != last;++first) {
 		n += (*first == value);
@@ -177,6 +177,30 @@ count(ForwardIterator first, ForwardIterator last, T value) {
 	return n;
 }
 
+// 分段迭代器逐段计数
+template <typename ForwardIterator, typename T>
+static typename iterator_traits<ForwardIterator>::difference_type
+__count(ForwardIterator first, ForwardIterator last, const T &value, true_type) {
+	using traits = segmented_iterator_traits<ForwardIterator>;
+	auto sf = traits::segment(first);
+	auto sl = traits::segment(last);
+	if(sf == sl) {
+		return __count(traits::local(first), traits::local(last), value, false_type());
+	}
+	typename iterator_traits<ForwardIterator>::difference_type n =
+		__count(traits::local(first), traits::end(sf), value, false_type());
+	for(++sf;sf != sl;++sf) {
+		n += __count(traits::begin(sf), traits::end(sf), value, false_type());
+	}
+	return n + __count(traits::begin(sl), traits::local(last), value, false_type());
+}
+
+template <typename ForwardIterator, typename T>
+typename iterator_traits<ForwardIterator>::difference_type
+count(ForwardIterator first, ForwardIterator last, T value) {
+	return __count(first, last, value, typename segmented_iterator_traits<ForwardIterator>::is_segmented());
+}
+
 template <typename ForwardIterator, typename BP>
 typename iterator_traits<ForwardIterator>::difference_type
 count_if(ForwardIterator first, ForwardIterator last, BP op) {
@@ -189,16 +213,55 @@ count_if(ForwardIterator first, ForwardIterator last, BP op) {
 	return n;
 }
 
+template <typename InputIterator, typename BP>
+static InputIterator __find_if(InputIterator first, InputIterator last, BP op, false_type) {
+	for(;first != last && !op(*first);++first);
+	return first;
+}
+
+// 分段迭代器逐段查找，找到时由段与段内位置合成迭代器
+template <typename InputIterator, typename BP>
+static InputIterator __find_if(InputIterator first, InputIterator last, BP op, true_type) {
+	using traits = segmented_iterator_traits<InputIterator>;
+	auto sf = traits::segment(first);
+	auto sl = traits::segment(last);
+	if(sf == sl) {
+		auto p = __find_if(traits::local(first), traits::local(last), op, false_type());
+		return p == traits::local(last) ? last : traits::compose(sf, p);
+	}
+	auto p = __find_if(traits::local(first), traits::end(sf), op, false_type());
+	if(p != traits::end(sf)) {
+		return traits::compose(sf, p);
+	}
+	for(++sf;sf != sl;++sf) {
+		p = __find_if(traits::begin(sf), traits::end(sf), op, false_type());
+		if(p != traits::end(sf)) {
+			return traits::compose(sf, p);
+		}
+	}
+	p = __find_if(traits::begin(sl), traits::local(last), op, false_type());
+	return p == traits::local(last) ? last : traits::compose(sl, p);
+}
+
+template <typename T>
+struct __equal_to_value {
+	const T &value;
+
+	template <typename U>
+	inline bool operator()(U &&x) const {
+		return x == value;
+	}
+}; // struct __equal_to_value
+
 template <typename InputIterator, typename T>
 InputIterator find(InputIterator first, InputIterator last, const T &value) {
-	for(;first != last && !(*first == value);++first);
-	return first;
+	return __find_if(first, last, __equal_to_value<T>{ value },
+		typename segmented_iterator_traits<InputIterator>::is_segmented());
 }
 
 template <typename InputIterator, typename BP>
 InputIterator find_if(InputIterator first, InputIterator last, BP op) {
-	for(;first != last && !op(*first);++first);
-	return first;
+	return __find_if(first, last, op, typename segmented_iterator_traits<InputIterator>::is_segmented());
 }
 
 template <typename InputIterator1, typename InputIterator2>
@@ -248,13 +311,34 @@ InputIterator1 find_first_of(InputIterator1 first1, InputIterator1 last1,
 }
 
 template <typename InputIterator, typename Func>
-Func for_each(InputIterator first, InputIterator last, Func f) {
+static Func __for_each(InputIterator first, InputIterator last, Func f, false_type) {
 	for(;first != last;++first) {
 		f(*first);
 	}
 	return f;
 }
 
+// 分段迭代器逐段遍历
+template <typename InputIterator, typename Func>
+static Func __for_each(InputIterator first, InputIterator last, Func f, true_type) {
+	using traits = segmented_iterator_traits<InputIterator>;
+	auto sf = traits::segment(first);
+	auto sl = traits::segment(last);
+	if(sf == sl) {
+		return __for_each(traits::local(first), traits::local(last), f, false_type());
+	}
+	f = __for_each(traits::local(first), traits::end(sf), f, false_type());
+	for(++sf;sf != sl;++sf) {
+		f = __for_each(traits::begin(sf), traits::end(sf), f, false_type());
+	}
+	return __for_each(traits::begin(sl), traits::local(last), f, false_type());
+}
+
+template <typename InputIterator, typename Func>
+Func for_each(InputIterator first, InputIterator last, Func f) {
+	return __for_each(first, last, f, typename segmented_iterator_traits<InputIterator>::is_segmented());
+}
+
 template <typename ForwardIterator, typename Func>
 void generate(ForwardIterator first, ForwardIterator last, Func gen) {
 	for(;first != last;++first) {
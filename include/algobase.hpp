@@ -26,15 +26,50 @@ bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, B
 	return true;
 }
 
+namespace {
+
 template <typename InputIterator, typename T>
-void fill(InputIterator first, InputIterator last, T value) {
+static void __fill(InputIterator first, InputIterator last, const T &value, false_type) {
 	for(;first != last;++first) {
 		*first = value;
 	}
 }
 
+// 单字节类型直接按字节填充
+template <typename T>
+static void __fill(char *first, char *last, const T &value, false_type) {
+	::memset(first, static_cast<unsigned char>(value), last - first);
+}
+
+template <typename T>
+static void __fill(signed char *first, signed char *last, const T &value, false_type) {
+	::memset(first, static_cast<unsigned char>(value), last - first);
+}
+
+template <typename T>
+static void __fill(unsigned char *first, unsigned char *last, const T &value, false_type) {
+	::memset(first, static_cast<unsigned char>(value), last - first);
+}
+
+// 分段迭代器逐段填充，段内以局部迭代器遍历
+template <typename InputIterator, typename T>
+static void __fill(InputIterator first, InputIterator last, const T &value, true_type) {
+	using traits = segmented_iterator_traits<InputIterator>;
+	auto sf = traits::segment(first);
+	auto sl = traits::segment(last);
+	if(sf == sl) {
+		__fill(traits::local(first), traits::local(last), value, false_type());
+		return;
+	}
+	__fill(traits::local(first), traits::end(sf), value, false_type());
+	for(++sf;sf != sl;++sf) {
+		__fill(traits::begin(sf), traits::end(sf), value, false_type());
+	}
+	__fill(traits::begin(sl), traits::local(last), value, false_type());
+}
+
 template <typename InputIterator, typename Size, typename T>
-InputIterator fill_n(InputIterator first, Size size, T value) {
+static InputIterator __fill_n(InputIterator first, Size size, const T &value, false_type) {
 	while(size--) {
 		*first = value;
 		++first;
@@ -42,6 +77,25 @@ InputIterator fill_n(InputIterator first, Size size, T value) {
 	return first;
 }
 
+template <typename InputIterator, typename Size, typename T>
+static InputIterator __fill_n(InputIterator first, Size size, const T &value, true_type) {
+	InputIterator last = first + size;
+	__fill(first, last, value, true_type());
+	return last;
+}
+
+} // namespace
+
+template <typename InputIterator, typename T>
+void fill(InputIterator first, InputIterator last, T value) {
+	__fill(first, last, value, typename segmented_iterator_traits<InputIterator>::is_segmented());
+}
+
+template <typename InputIterator, typename Size, typename T>
+InputIterator fill_n(InputIterator first, Size size, T value) {
+	return __fill_n(first, size, value, typename segmented_iterator_traits<InputIterator>::is_segmented());
+}
+
 template <typename ForwardIterator1, typename ForwardIterator2>
 void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
 	if(a == b) {
@@ -110,18 +164,8 @@ stl::Pair<InputIterator1, InputIterator2> mismatch(
 namespace {
 
 static void memmove(char *res, const char *first, size_t n) {
-	::memcpy(res, first, n);
-}
-
-template <typename T>
-static T *__copy_t(const T *first, const T *last, T *result, true_type) {
-	memmove((char *)result, (char *)first, sizeof(T) * (last - first));
-	return result + (last - first);
-}
-
-template <typename T>
-static T *__copy_t(const T *first, const T *last, T *result, false_type) {
-	return __copy_d(first, last, result, distance_type(first));
+	// 源与目标可能重叠，不能使用memcpy
+	::memmove(res, first, n);
 }
 
 template <typename InputIterator1, typename InputIterator2>
@@ -136,7 +180,7 @@ static InputIterator2 __copy(InputIterator1 first, InputIterator1 last,
 template <typename InputIterator1, typename InputIterator2, typename Distance>
 static InputIterator2 __copy_d(InputIterator1 first, InputIterator1 last,
 	InputIterator2 result, Distance *) {
-	for(Distance i = last - first;i >= 0;--i, ++result, ++first) {
+	for(Distance i = last - first;i > 0;--i, ++result, ++first) {
 		*result = *first;
 	}
 	return result;
@@ -145,7 +189,22 @@ static InputIterator2 __copy_d(InputIterator1 first, InputIterator1 last,
 template <typename InputIterator1, typename InputIterator2>
 static InputIterator2 __copy(InputIterator1 first, InputIterator1 last,
 	InputIterator2 result, stl::random_access_iterator_tag) {
-	return __copy_d(first, last, result, distance_type(first));
+	return __copy_d(first, last, result,
+		static_cast<typename iterator_traits<InputIterator1>::difference_type *>(nullptr));
+}
+
+// 可平凡赋值的类型整段复制内存
+template <typename T>
+static T *__copy_t(const T *first, const T *last, T *result, true_type) {
+	if(first != last) {
+		memmove((char *)result, (const char *)first, sizeof(T) * (last - first));
+	}
+	return result + (last - first);
+}
+
+template <typename T>
+static T *__copy_t(const T *first, const T *last, T *result, false_type) {
+	return __copy_d(first, last, result, static_cast<ptrdiff_t *>(nullptr));
 }
 
 template <typename InputIterator1, typename InputIterator2>
@@ -172,20 +231,80 @@ struct __copy_dispatch<const T *, T *> {
 	}
 };
 
+template <typename InputIterator1, typename InputIterator2>
+static InputIterator2 __copy_to_segments(InputIterator1 first, InputIterator1 last,
+	InputIterator2 result, stl::input_iterator_tag) {
+	return __copy_dispatch<InputIterator1, InputIterator2>()(first, last, result);
+}
+
+// 目标为分段迭代器时，按目标段的剩余空间切分源区间，每块复制到段内的局部迭代器
+template <typename InputIterator1, typename InputIterator2>
+static InputIterator2 __copy_to_segments(InputIterator1 first, InputIterator1 last,
+	InputIterator2 result, stl::random_access_iterator_tag) {
+	using traits = segmented_iterator_traits<InputIterator2>;
+	using local_iterator = typename traits::local_iterator;
+	using difference_type = typename iterator_traits<InputIterator1>::difference_type;
+	difference_type n = last - first;
+	while(n > 0) {
+		auto s = traits::segment(result);
+		local_iterator l = traits::local(result);
+		difference_type chunk = stl::min<difference_type>(n, traits::end(s) - l);
+		l = __copy_dispatch<InputIterator1, local_iterator>()(first, first + chunk, l);
+		first += chunk;
+		n -= chunk;
+		result = traits::compose(s, l);
+	}
+	return result;
+}
+
+template <typename InputIterator1, typename InputIterator2, typename SegmentedResult>
+static InputIterator2 __copy_segmented(InputIterator1 first, InputIterator1 last,
+	InputIterator2 result, false_type, SegmentedResult) {
+	return __copy_dispatch<InputIterator1, InputIterator2>()(first, last, result);
+}
+
+template <typename InputIterator1, typename InputIterator2>
+static InputIterator2 __copy_segmented(InputIterator1 first, InputIterator1 last,
+	InputIterator2 result, false_type, true_type) {
+	return __copy_to_segments(first, last, result, iterator_category(first));
+}
+
+// 源为分段迭代器时逐段复制，每段再按目标类型分派
+template <typename InputIterator1, typename InputIterator2, typename SegmentedResult>
+static InputIterator2 __copy_segmented(InputIterator1 first, InputIterator1 last,
+	InputIterator2 result, true_type, SegmentedResult) {
+	using traits = segmented_iterator_traits<InputIterator1>;
+	using local_iterator = typename traits::local_iterator;
+	auto sf = traits::segment(first);
+	auto sl = traits::segment(last);
+	if(sf == sl) {
+		return __copy_segmented(traits::local(first), traits::local(last), result,
+			false_type(), SegmentedResult());
+	}
+	result = __copy_segmented(traits::local(first), traits::end(sf), result, false_type(), SegmentedResult());
+	for(++sf;sf != sl;++sf) {
+		result = __copy_segmented(local_iterator(traits::begin(sf)), traits::end(sf), result,
+			false_type(), SegmentedResult());
+	}
+	return __copy_segmented(traits::begin(sl), traits::local(last), result, false_type(), SegmentedResult());
+}
+
 } // namespace
 
 template <typename InputIterator1, typename InputIterator2>
 InputIterator2 copy(InputIterator1 first, InputIterator1 last, InputIterator2 result) {
-	return __copy_dispatch<InputIterator1, InputIterator2>()(first, last, result);
+	return __copy_segmented(first, last, result,
+		typename segmented_iterator_traits<InputIterator1>::is_segmented(),
+		typename segmented_iterator_traits<InputIterator2>::is_segmented());
 }
 
-char *copy(const char *first, const char *last, char *result) {
+inline char *copy(const char *first, const char *last, char *result) {
 	memmove(result, first, last - first);
 	return result + (last - first);
 }
 
-wchar_t *copy(const wchar_t *first, const wchar_t *last, wchar_t *result) {
-	memmove((char *)result, (char *)first, sizeof(wchar_t) * (last - first));
+inline wchar_t *copy(const wchar_t *first, const wchar_t *last, wchar_t *result) {
+	memmove((char *)result, (const char *)first, sizeof(wchar_t) * (last - first));
 	return result + (last - first);
 }
 
@@ -0,0 +1,161 @@
+#ifndef _ALIGNED_ALLOCATOR_HPP__
+#define _ALIGNED_ALLOCATOR_HPP__
+
+/**
+ * 对齐空间配置器
+ * 分配的内存起始地址按Align对齐，便于向量化指令使用对齐读写
+ * 定义_TINY_STL_MEMORY_POOL_宏时，小块内存取自伙伴系统，伙伴块天然按自身大小对齐
+ * 定义_TINY_STL_MMAP_ALLOC_宏时，大块内存使用mmap，映射按页对齐
+*/
+
+#include <new>
+#include <utility>
+#include <cstdlib>
+
+#include <stdint.h>
+
+#include "allocator.hpp"
+
+namespace stl {
+
+template <typename T, size_t Align = 64>
+class AlignedAllocator {
+public:
+	// 定义类型
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = size_t;
+	using difference_type = ::ptrdiff_t;
+
+	// 起始地址的对齐保证
+	static constexpr size_type alignment = Align < alignof(T) ? alignof(T) : Align;
+
+	static_assert((Align & (Align - 1)) == 0, "alignment must be a power of two");
+
+	// 嵌套类型
+	template <typename U>
+	struct rebind {
+		using other = AlignedAllocator<U, Align>;
+	}; // struct rebind
+private:
+#ifdef _TINY_STL_MEMORY_POOL_
+	// 二级空间配置器实例
+	Alloc m_alloc_;
+
+	// 向伙伴系统申请的字节数，不小于对齐值以保证块按对齐值对齐
+	static inline size_type pool_size(size_type n) {
+		return n < alignment ? alignment : n;
+	}
+#endif
+
+#ifdef _TINY_STL_MMAP_ALLOC_
+	// 大块内存配置器实例
+	MmapAlloc m_mmap_alloc_;
+
+	// 页大小的下限，不超过该值的对齐可由mmap满足
+	static constexpr size_type min_page_size = 4096;
+
+	static inline bool use_mmap(size_type n) {
+		return alignment <= min_page_size && n >= MmapAlloc::mmap_threshold;
+	}
+#endif
+public:
+	// 构造函数
+	AlignedAllocator() = default;
+	AlignedAllocator(const AlignedAllocator &) = default;
+	~AlignedAllocator() = default;
+
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U, Align> &u) {
+	}
+
+	// 获取对象地址
+	inline pointer address(reference x) const {
+		return static_cast<pointer>(&x);
+	}
+
+	inline const_pointer address(const_reference x) const {
+		return static_cast<const_pointer>(&x);
+	}
+
+	// 分配内存空间
+	pointer allocate(size_type n, const void *p = nullptr) {
+		size_type bytes = n * sizeof(value_type);
+#ifdef _TINY_STL_MEMORY_POOL_
+		if(pool_size(bytes) <= Alloc::max_block_size) {
+			return static_cast<pointer>(m_alloc_.allocate(pool_size(bytes), p));
+		}
+#endif
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(use_mmap(bytes)) {
+			return static_cast<pointer>(m_mmap_alloc_.allocate(bytes, p));
+		}
+#endif
+		(void)p;
+		void *mem = nullptr;
+		size_type align = alignment < sizeof(void *) ? sizeof(void *) : alignment;
+		if(::posix_memalign(&mem, align, bytes == 0 ? align : bytes) != 0) {
+			throw std::bad_alloc();
+		}
+		return static_cast<pointer>(mem);
+	}
+
+	// 释放内存空间
+	void deallocate(pointer p, size_type n) {
+#ifdef _TINY_STL_MEMORY_POOL_
+		if(pool_size(n * sizeof(value_type)) <= Alloc::max_block_size) {
+			m_alloc_.deallocate(p, pool_size(n * sizeof(value_type)));
+			return;
+		}
+#endif
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(use_mmap(n * sizeof(value_type))) {
+			m_mmap_alloc_.deallocate(p, n * sizeof(value_type));
+			return;
+		}
+#endif
+		(void)n;
+		::free(p);
+	}
+
+	// 将容纳old_n个对象的内存调整为容纳new_n个对象，内容按字节保留，
+	// 仅适用于可按位搬移的类型，无法原地调整时返回nullptr
+	pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(use_mmap(old_n * sizeof(value_type)) && use_mmap(new_n * sizeof(value_type))) {
+			return static_cast<pointer>(m_mmap_alloc_.reallocate(p,
+				old_n * sizeof(value_type), new_n * sizeof(value_type)));
+		}
+#endif
+		(void)p;
+		(void)old_n;
+		(void)new_n;
+		return nullptr;
+	}
+
+	// 对象最大数量
+	size_type max_size() const {
+		return static_cast<size_type>(UINT32_MAX / sizeof(value_type));
+	}
+
+	// 使用对应指针进行构造
+	template <typename ... Args>
+	void construct(pointer p, Args&& ... x) {
+		new(p) value_type(std::forward<Args>(x)...);
+	}
+
+	// 使用对应指针进行析构
+	void destory(pointer p) {
+		p->~value_type();
+	}
+}; // class AlignedAllocator
+
+template <typename T, size_t Align>
+constexpr typename AlignedAllocator<T, Align>::size_type AlignedAllocator<T, Align>::alignment;
+
+} // namespace stl
+
+#endif // _ALIGNED_ALLOCATOR_HPP__
@@ -2,106 +2,569 @@
 #define _ALLOC_HPP__
 
 #include <new>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 #include <cstddef>
 
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
 #include <cassert>
 
 namespace stl {
 
-// 使用伙伴系统进行分配
+// 使用伙伴系统进行分配，每个线程持有独立实例及按大小类划分的缓存
 class Alloc {
 public:
 	using size_type = size_t;
 	using difference_type = ::ptrdiff_t;
+
+	// 每块内存池大小，内存池按此大小对齐
+	static constexpr size_type memory_pool_size = 32 * 1024;
+	// 伙伴链层数，第0层为min_block_size，后一层大小为其前一层大小的2倍
+	static constexpr size_type pool_level = 8;
+	// 空闲块需容纳前后两个指针
+	static constexpr size_type min_block_size = 16;
+	static constexpr size_type max_block_size = min_block_size << (pool_level - 1);
+	// 每个大小类线程缓存的字节数上限
+	static constexpr size_type thread_cache_size = 64 * 1024;
 private:
+	// 获取容纳n字节所需的伙伴层
+	static constexpr size_type level_of(size_type n, size_type level = 0) {
+		return (min_block_size << level) >= n ? level : level_of(n, level + 1);
+	}
+
+	// 第level层伙伴位在位图中的起始位置
+	static constexpr size_type pair_offset(size_type level) {
+		return memory_pool_size / min_block_size - memory_pool_size / (min_block_size << level);
+	}
+
+	// 空闲块，使用双向链表以便合并时直接摘除伙伴
+	struct FreeBlock {
+		FreeBlock *m_next_;
+		FreeBlock *m_prev_;
+	}; // struct FreeBlock
+
+	// 其他线程归还的内存块，挂入所属实例的远程回收队列
+	struct RemoteBlock {
+		RemoteBlock *m_next_;
+		size_type m_level_;
+	}; // struct RemoteBlock
+
+	class AllocInstance;
+
+	// 内存池头部，占用每块内存池的起始空间
+	struct ChunkHeader {
+		ChunkHeader *m_next_;
+		ChunkHeader *m_prev_;
+		// 内存池所属实例
+		AllocInstance *m_owner_;
+		// 已从伙伴系统分配出的字节数，不含头部，线程缓存中的块视为已分配
+		size_type m_used_;
+		// 最近一次完全空闲的时刻，单位为毫秒
+		int64_t m_idle_since_;
+		// 伙伴位图，每对伙伴占一位，其值为两伙伴是否空闲的异或
+		unsigned char m_buddy_map_[(memory_pool_size / min_block_size -
+			memory_pool_size / max_block_size + 7) / 8];
+	}; // struct ChunkHeader
+
+	static_assert(sizeof(FreeBlock) <= min_block_size, "min block too small");
+	static_assert(sizeof(RemoteBlock) <= min_block_size, "min block too small");
+	static_assert((memory_pool_size & (memory_pool_size - 1)) == 0,
+		"memory pool size must be power of 2");
+	static_assert(memory_pool_size > max_block_size,
+		"memory pool must hold more than one max block");
+
+	// 头部所占用的伙伴层
+	static constexpr size_type header_level() {
+		return level_of(sizeof(ChunkHeader));
+	}
+
+	// 获取指针所在内存池
+	static inline ChunkHeader *chunk_of(const void *p) {
+		return reinterpret_cast<ChunkHeader *>(
+			reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(memory_pool_size - 1));
+	}
+
+	// 单调时钟的当前毫秒数
+	static inline int64_t now_ms() {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// 完全空闲的内存池保留多久后归还系统，单位为毫秒，小于0时不自动归还
+	static inline std::atomic<int64_t> &decay_time() {
+		static std::atomic<int64_t> time(-1);
+		return time;
+	}
+
+	// 累计归还系统的字节数
+	static inline std::atomic<size_type> &reclaimed() {
+		static std::atomic<size_type> bytes(0);
+		return bytes;
+	}
+
 	class AllocInstance {
-		// 预分配内存
-		char *const m_buffer_start_;
-		char *const m_buffer_end_;
-		// 伙伴链，第0位为8B，后一位大小为其前一位大小的2倍
-		char *m_pool_list_head_[8];
-		char *m_pool_list_tail_[8];
+		// 伙伴链
+		FreeBlock *m_pool_list_head_[pool_level];
+		// 线程缓存，按伙伴层划分大小类，仅使用m_next_组成单链表
+		FreeBlock *m_cache_head_[pool_level];
+		size_type m_cache_count_[pool_level];
+		// 远程回收队列，其他线程无锁压入，所属线程整批取出
+		std::atomic<RemoteBlock *> m_remote_head_;
+		// 已申请的内存池
+		ChunkHeader *m_chunk_list_;
+		// 上次按衰减策略检查内存池的时刻
+		int64_t m_last_decay_;
+		// 空闲实例链
+		AllocInstance *m_next_idle_;
+
+		// 第level层线程缓存可容纳的内存块数量
+		static constexpr size_type cache_limit(size_type level) {
+			return thread_cache_size / (min_block_size << level);
+		}
+
+		// 获取第level层内存块的伙伴
+		static inline char *buddy_of(char *p, size_type level) {
+			char *base = reinterpret_cast<char *>(chunk_of(p));
+			return base + ((p - base) ^ (min_block_size << level));
+		}
+
+		// 第level层内存块对应伙伴位在位图中的位置
+		static inline size_type buddy_bit(char *p, size_type level) {
+			return pair_offset(level) +
+				(p - reinterpret_cast<char *>(chunk_of(p))) / (min_block_size << (level + 1));
+		}
+
+		// 翻转内存块对应的伙伴位，返回翻转后伙伴是否处于不同状态
+		static inline bool flip_buddy_bit(char *p, size_type level) {
+			ChunkHeader *chunk = chunk_of(p);
+			size_type bit = buddy_bit(p, level);
+			unsigned char mask = static_cast<unsigned char>(1u << (bit & 7));
+			chunk->m_buddy_map_[bit >> 3] ^= mask;
+			return (chunk->m_buddy_map_[bit >> 3] & mask) != 0;
+		}
+
+		// 已分配内存块的伙伴是否空闲于伙伴链中
+		static inline bool buddy_free(char *p, size_type level) {
+			size_type bit = buddy_bit(p, level);
+			return (chunk_of(p)->m_buddy_map_[bit >> 3] & (1u << (bit & 7))) != 0;
+		}
+
+		// 将内存块挂入第level层伙伴链
+		inline void push_block(char *p, size_type level) {
+			FreeBlock *block = reinterpret_cast<FreeBlock *>(p);
+			block->m_prev_ = nullptr;
+			block->m_next_ = m_pool_list_head_[level];
+			if(block->m_next_ != nullptr) {
+				block->m_next_->m_prev_ = block;
+			}
+			m_pool_list_head_[level] = block;
+		}
+
+		// 将内存块从第level层伙伴链中摘除
+		inline void remove_block(char *p, size_type level) {
+			FreeBlock *block = reinterpret_cast<FreeBlock *>(p);
+			if(block->m_prev_ != nullptr) {
+				block->m_prev_->m_next_ = block->m_next_;
+			} else {
+				m_pool_list_head_[level] = block->m_next_;
+			}
+			if(block->m_next_ != nullptr) {
+				block->m_next_->m_prev_ = block->m_prev_;
+			}
+		}
+
+		// 将第from层的已摘除内存块拆分至第to层，拆出的后半部分挂入对应伙伴链
+		inline char *split(char *p, size_type from, size_type to) {
+			while(from > to) {
+				--from;
+				flip_buddy_bit(p, from);
+				push_block(p + (min_block_size << from), from);
+			}
+			return p;
+		}
+
+		// 申请一块新的内存池
+		void grow() {
+			static_assert(header_level() < pool_level - 1, "chunk header too large");
+
+			void *mem = nullptr;
+			if(::posix_memalign(&mem, memory_pool_size, memory_pool_size) != 0) {
+				throw std::bad_alloc();
+			}
+			ChunkHeader *chunk = static_cast<ChunkHeader *>(mem);
+			::memset(chunk->m_buddy_map_, 0, sizeof(chunk->m_buddy_map_));
+			chunk->m_owner_ = this;
+			chunk->m_used_ = 0;
+			chunk->m_idle_since_ = 0;
+			chunk->m_prev_ = nullptr;
+			chunk->m_next_ = m_chunk_list_;
+			if(m_chunk_list_ != nullptr) {
+				m_chunk_list_->m_prev_ = chunk;
+			}
+			m_chunk_list_ = chunk;
+
+			char *base = static_cast<char *>(mem);
+			for(char *p = base + memory_pool_size - max_block_size;p != base;p -= max_block_size) {
+				push_block(p, pool_level - 1);
+			}
+
+			// 首块拆分至头部所在层，头部所在块视为永久占用
+			split(base, pool_level - 1, header_level());
+		}
+
+		// 从伙伴系统分配第level层内存块
+		char *buddy_allocate(size_type level) {
+			size_type cur = level;
+			while(cur < pool_level && m_pool_list_head_[cur] == nullptr) {
+				++cur;
+			}
+			if(cur == pool_level) {
+				grow();
+				cur = level;
+				while(m_pool_list_head_[cur] == nullptr) {
+					++cur;
+				}
+			}
+
+			char *p = reinterpret_cast<char *>(m_pool_list_head_[cur]);
+			remove_block(p, cur);
+			if(cur < pool_level - 1) {
+				flip_buddy_bit(p, cur);
+			}
+			chunk_of(p)->m_used_ += min_block_size << level;
+			return split(p, cur, level);
+		}
+
+		// 将第level层内存块归还伙伴系统
+		void buddy_deallocate(char *p, size_type level) {
+			ChunkHeader *chunk = chunk_of(p);
+			chunk->m_used_ -= min_block_size << level;
+
+			// 伙伴空闲时与其合并，并继续向上一层尝试合并
+			while(level < pool_level - 1 && !flip_buddy_bit(p, level)) {
+				char *buddy = buddy_of(p, level);
+				remove_block(buddy, level);
+				if(buddy < p) {
+					p = buddy;
+				}
+				++level;
+			}
+			push_block(p, level);
+
+			if(chunk->m_used_ == 0) {
+				chunk_idle(chunk);
+			}
+		}
 
-		// 判断一个指针是否在内存池中
-		inline bool in_memory(const char *p) const {
-			return m_buffer_start_ <= p && p < m_buffer_end_;
+		// 内存池完全空闲时按衰减策略决定是否归还系统
+		void chunk_idle(ChunkHeader *chunk) {
+			int64_t decay = decay_time().load(std::memory_order_relaxed);
+			if(decay < 0) {
+				return;
+			}
+			if(decay == 0) {
+				release_chunk(chunk);
+				return;
+			}
+			int64_t now = now_ms();
+			chunk->m_idle_since_ = now;
+			if(now - m_last_decay_ >= decay) {
+				m_last_decay_ = now;
+				trim(now - decay);
+			}
+		}
+
+		// 将完全空闲的内存池摘出伙伴链并归还系统，返回归还的字节数
+		size_type release_chunk(ChunkHeader *chunk) {
+			// 完全空闲时除头部外均已合并，头部所在的首个最大块拆分后各层各余一块
+			char *base = reinterpret_cast<char *>(chunk);
+			for(size_type level = header_level();level < pool_level - 1;++level) {
+				remove_block(base + (min_block_size << level), level);
+			}
+			for(char *p = base + max_block_size;p != base + memory_pool_size;p += max_block_size) {
+				remove_block(p, pool_level - 1);
+			}
+
+			if(chunk->m_prev_ != nullptr) {
+				chunk->m_prev_->m_next_ = chunk->m_next_;
+			} else {
+				m_chunk_list_ = chunk->m_next_;
+			}
+			if(chunk->m_next_ != nullptr) {
+				chunk->m_next_->m_prev_ = chunk->m_prev_;
+			}
+
+#ifdef MADV_DONTNEED
+			// 先丢弃物理页，避免free后内存仍驻留在堆中
+			::madvise(chunk, memory_pool_size, MADV_DONTNEED);
+#endif // MADV_DONTNEED
+			::free(chunk);
+			reclaimed().fetch_add(memory_pool_size, std::memory_order_relaxed);
+			return memory_pool_size;
 		}
 
-		// 在一个内存块前部设置next指针已形成链表，要求ptr指向内存块大小大于指针大小
-		inline void set_next_ptr(char *ptr, char *next) {
-			*((char **)ptr) = next;
+		// 归还在idle_before时刻前已完全空闲的内存池，返回归还的字节数
+		size_type trim(int64_t idle_before) {
+			size_type bytes = 0;
+			ChunkHeader *chunk = m_chunk_list_;
+			while(chunk != nullptr) {
+				ChunkHeader *next = chunk->m_next_;
+				if(chunk->m_used_ == 0 && chunk->m_idle_since_ <= idle_before) {
+					bytes += release_chunk(chunk);
+				}
+				chunk = next;
+			}
+			return bytes;
 		}
 
-		// 获得一个内存块的next指针
-		inline char *get_next_ptr(char *ptr) {
-			return *((char **)ptr);
+		// 将第from层已分配内存块原地扩展至第to层，
+		// 要求其在各层均为前半部分且伙伴空闲于伙伴链中
+		bool expand(char *p, size_type from, size_type to) {
+			char *base = reinterpret_cast<char *>(chunk_of(p));
+			for(size_type level = from;level < to;++level) {
+				if(((p - base) & (min_block_size << level)) != 0 || !buddy_free(p, level)) {
+					return false;
+				}
+			}
+			for(size_type level = from;level < to;++level) {
+				remove_block(p + (min_block_size << level), level);
+				flip_buddy_bit(p, level);
+			}
+			chunk_of(p)->m_used_ += (min_block_size << to) - (min_block_size << from);
+			return true;
+		}
+
+		// 取出远程回收队列中的全部内存块并在本地回收
+		void drain_remote() {
+			if(m_remote_head_.load(std::memory_order_relaxed) == nullptr) {
+				return;
+			}
+			RemoteBlock *block = m_remote_head_.exchange(nullptr, std::memory_order_acquire);
+			while(block != nullptr) {
+				RemoteBlock *next = block->m_next_;
+				deallocate(block, block->m_level_);
+				block = next;
+			}
 		}
 	public:
-		AllocInstance(size_type size) :
-			m_buffer_start_(static_cast<char *>(::operator new(size))),
-			m_buffer_end_(m_buffer_start_ + size),
+		AllocInstance() :
 			m_pool_list_head_{ nullptr },
-			m_pool_list_tail_{ nullptr } {
-			static_assert(min_block_size >= sizeof(void *));
-
-			// 要求内存池大小必须不为0且为1024倍数
-			assert(size >= max_block_size && (size & 0x3ff) == 0);
+			m_cache_head_{ nullptr },
+			m_cache_count_{ 0 },
+			m_remote_head_(nullptr),
+			m_chunk_list_(nullptr),
+			m_last_decay_(0),
+			m_next_idle_(nullptr) {
+		}
 
-			// 设置内存块起始地址
-			m_pool_list_head_[7] = m_buffer_start_;
+		AllocInstance(const AllocInstance &) = delete;
+		AllocInstance &operator=(const AllocInstance &) = delete;
 
-			// 设置第一块内存
-			char *p = m_pool_list_head_[7];
-			size -= max_block_size;
+		// 分配第level层内存块
+		inline void *allocate(size_type level) {
+			FreeBlock *block = m_cache_head_[level];
+			if(block == nullptr) {
+				drain_remote();
+				block = m_cache_head_[level];
+				if(block == nullptr) {
+					return buddy_allocate(level);
+				}
+			}
+			m_cache_head_[level] = block->m_next_;
+			--m_cache_count_[level];
+			return block;
+		}
 
-			// 设置接下来的块内存
-			while(size >= max_block_size) {
-				set_next_ptr(p, p + max_block_size);
-				p = get_next_ptr(p);
-				size -= max_block_size;
+		// 由所属线程回收第level层内存块
+		inline void deallocate(void *p, size_type level) {
+			if(m_cache_count_[level] < cache_limit(level)) {
+				FreeBlock *block = static_cast<FreeBlock *>(p);
+				block->m_next_ = m_cache_head_[level];
+				m_cache_head_[level] = block;
+				++m_cache_count_[level];
+			} else {
+				buddy_deallocate(static_cast<char *>(p), level);
 			}
+		}
 
-			// 设置尾块next指针为nullptr
-			set_next_ptr(p - max_block_size, nullptr);
+		// 由其他线程回收第level层内存块
+		inline void remote_deallocate(void *p, size_type level) {
+			RemoteBlock *block = static_cast<RemoteBlock *>(p);
+			block->m_level_ = level;
+			block->m_next_ = m_remote_head_.load(std::memory_order_relaxed);
+			while(!m_remote_head_.compare_exchange_weak(block->m_next_, block,
+				std::memory_order_release, std::memory_order_relaxed));
+		}
 
-			// 设置尾指针
-			m_pool_list_tail_[7] = p;
+		// 线程退出时清空缓存，使内存块尽可能合并
+		void flush() {
+			drain_remote();
+			for(size_type level = 0;level < pool_level;++level) {
+				FreeBlock *block = m_cache_head_[level];
+				while(block != nullptr) {
+					FreeBlock *next = block->m_next_;
+					buddy_deallocate(reinterpret_cast<char *>(block), level);
+					block = next;
+				}
+				m_cache_head_[level] = nullptr;
+				m_cache_count_[level] = 0;
+			}
 		}
 
-		~AllocInstance() {
-			::operator delete(m_buffer_start_);
+		friend class Alloc;
+	}; // class AllocInstance
+
+	// 空闲实例链的互斥锁
+	static inline std::mutex &idle_mutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	// 空闲实例链，线程退出后其实例连同内存池一并挂入，供新线程接管
+	static inline AllocInstance *&idle_list() {
+		static AllocInstance *list = nullptr;
+		return list;
+	}
+
+	// 获取一个实例，优先接管已退出线程留下的实例
+	static AllocInstance *acquire_instance() {
+		{
+			std::lock_guard<std::mutex> lock(idle_mutex());
+			AllocInstance *&list = idle_list();
+			if(list != nullptr) {
+				AllocInstance *instance = list;
+				list = instance->m_next_idle_;
+				instance->m_next_idle_ = nullptr;
+				return instance;
+			}
 		}
+		return new AllocInstance();
+	}
+
+	// 归还实例，实例与其内存池在进程结束前不会释放
+	static void release_instance(AllocInstance *instance) {
+		instance->flush();
+		std::lock_guard<std::mutex> lock(idle_mutex());
+		AllocInstance *&list = idle_list();
+		instance->m_next_idle_ = list;
+		list = instance;
+	}
+
+	// 当前线程绑定的实例，线程未绑定或已退出时为nullptr
+	static inline AllocInstance *&local_instance() {
+		static thread_local AllocInstance *instance = nullptr;
+		return instance;
+	}
+
+	// 当前线程是否已退出
+	static inline bool &thread_exited() {
+		static thread_local bool exited = false;
+		return exited;
+	}
 
-		// 分配n字节内存
-		inline void *allocate(size_type n, const void *p = nullptr) {
-			assert(n <= max_block_size);
+	// 线程退出时归还所绑定的实例
+	struct ThreadGuard {
+		~ThreadGuard() {
+			AllocInstance *&instance = local_instance();
+			release_instance(instance);
+			instance = nullptr;
+			thread_exited() = true;
 		}
+	}; // struct ThreadGuard
 
-		// 回收n字节内存
-		inline void deallocate(void *p, size_type n) {
+	// 未绑定实例时的分配路径
+	static void *allocate_unbound(size_type level) {
+		if(thread_exited()) {
+			// 线程退出阶段的分配临时借用一个实例
+			AllocInstance *instance = acquire_instance();
+			void *res = instance->allocate(level);
+			release_instance(instance);
+			return res;
 		}
-	}; // class Memory
-public:
-	static constexpr size_type memory_pool_size = 32 * 1024;
-	static constexpr size_type max_block_size = 1024;
-	static constexpr size_type min_block_size = 8;
-private:
-	// 预分配内存
-	static thread_local AllocInstance m_alloc_instance_;
+		static thread_local ThreadGuard guard;
+		AllocInstance *&instance = local_instance();
+		instance = acquire_instance();
+		(void)guard;
+		return instance->allocate(level);
+	}
 public:
 	// 分配n字节内存
-	inline void *allocate(size_type n, const void *p = nullptr) {
-		return m_alloc_instance_.allocate(n, p);
+	inline void *allocate(size_type n, const void * = nullptr) {
+		assert(n <= max_block_size);
+
+		AllocInstance *instance = local_instance();
+		if(instance == nullptr) {
+			return allocate_unbound(level_of(n));
+		}
+		return instance->allocate(level_of(n));
+	}
+
+	// n字节请求实际获得的字节数
+	static inline size_type usable_size(size_type n) {
+		return min_block_size << level_of(n);
 	}
 
-	// 回收n字节内存
+	// 将old_n字节内存原地扩展为new_n字节，仅所属线程可扩展，失败返回false
+	inline bool expand(void *p, size_type old_n, size_type new_n) {
+		assert(old_n <= max_block_size);
+
+		if(new_n > max_block_size) {
+			return false;
+		}
+		AllocInstance *owner = chunk_of(p)->m_owner_;
+		if(owner != local_instance()) {
+			return false;
+		}
+		return owner->expand(static_cast<char *>(p), level_of(old_n), level_of(new_n));
+	}
+
+	// 清空当前线程的缓存，并将当前线程及空闲实例中完全空闲的内存池归还系统，
+	// 返回归还的字节数
+	static size_type trim() {
+		size_type bytes = 0;
+		AllocInstance *instance = local_instance();
+		if(instance != nullptr) {
+			instance->flush();
+			bytes += instance->trim(INT64_MAX);
+		}
+		// 空闲实例不再有所属线程，其他线程归还的内存块滞留在远程回收队列中，先行回收
+		std::lock_guard<std::mutex> lock(idle_mutex());
+		for(instance = idle_list();instance != nullptr;instance = instance->m_next_idle_) {
+			instance->flush();
+			bytes += instance->trim(INT64_MAX);
+		}
+		return bytes;
+	}
+
+	// 设置衰减策略，完全空闲的内存池保留time后归还系统，
+	// 为0时立即归还，小于0时仅由trim归还
+	static inline void set_decay_time(std::chrono::milliseconds time) {
+		decay_time().store(time.count(), std::memory_order_relaxed);
+	}
+
+	// 累计归还系统的字节数
+	static inline size_type reclaimed_bytes() {
+		return reclaimed().load(std::memory_order_relaxed);
+	}
+
+	// 回收n字节内存，非所属线程回收时交由所属实例的远程回收队列
 	inline void deallocate(void *p, size_type n) {
-		m_alloc_instance_.deallocate(p, n);
+		assert(n <= max_block_size);
+
+		AllocInstance *owner = chunk_of(p)->m_owner_;
+		if(owner == local_instance()) {
+			owner->deallocate(p, level_of(n));
+		} else {
+			owner->remote_deallocate(p, level_of(n));
+		}
 	}
 }; // class Alloc
 
-thread_local Alloc::AllocInstance Alloc::m_alloc_instance_(Alloc::memory_pool_size);
-
 } // namespace stl
 
-#endif // _ALLOC_HPP__
\ No newline at end of file
+#endif // _ALLOC_HPP__
@@ -0,0 +1,275 @@
+#ifndef _ALLOC_STATS_HPP__
+#define _ALLOC_STATS_HPP__
+
+/**
+ * 内存分配统计
+ * StatAllocator包装其他空间配置器，按Tag将统计结果记录到全局注册表中，
+ * rebind后的配置器沿用同一Tag，因此容器内部的结点与桶等分配均计入同一记录
+ * 记录只按Tag区分而不按容器区分，Tag默认为元素类型，使用相同Tag的所有容器共用一条记录；
+ * 需要分别统计时，调用方须为每个容器传入互不相同的Tag
+*/
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+#include <typeinfo>
+
+#include <stdint.h>
+
+#include "allocator.hpp"
+
+namespace stl {
+
+// 一组分配统计
+class AllocStats {
+public:
+	using size_type = size_t;
+
+	// 直方图按分配字节数的二进制位数划分大小类
+	static constexpr size_type size_class_number = 48;
+private:
+	const char *m_name_;
+	AllocStats *m_next_;
+
+	std::atomic<size_type> m_allocations_;
+	std::atomic<size_type> m_deallocations_;
+	std::atomic<size_type> m_bytes_live_;
+	std::atomic<size_type> m_peak_bytes_;
+	std::atomic<size_type> m_histogram_[size_class_number];
+
+	// 注册表头指针
+	static inline AllocStats *&registry_head() {
+		static AllocStats *head = nullptr;
+		return head;
+	}
+
+	static inline std::mutex &registry_mutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+public:
+	explicit AllocStats(const char *name) :
+		m_name_(name),
+		m_next_(nullptr),
+		m_allocations_(0),
+		m_deallocations_(0),
+		m_bytes_live_(0),
+		m_peak_bytes_(0) {
+		for(size_type i = 0;i < size_class_number;++i) {
+			m_histogram_[i].store(0, std::memory_order_relaxed);
+		}
+		std::lock_guard<std::mutex> lock(registry_mutex());
+		m_next_ = registry_head();
+		registry_head() = this;
+	}
+
+	AllocStats(const AllocStats &) = delete;
+	AllocStats &operator=(const AllocStats &) = delete;
+
+	// n字节内存所属的大小类，第i类包含(2^(i-1), 2^i]字节
+	static inline size_type size_class(size_type n) {
+		size_type c = 0;
+		while(c + 1 < size_class_number && (static_cast<size_type>(1) << c) < n) {
+			++c;
+		}
+		return c;
+	}
+
+	// 记录一次n字节的分配
+	void record_allocate(size_type n) {
+		m_allocations_.fetch_add(1, std::memory_order_relaxed);
+		m_histogram_[size_class(n)].fetch_add(1, std::memory_order_relaxed);
+		size_type live = m_bytes_live_.fetch_add(n, std::memory_order_relaxed) + n;
+		size_type peak = m_peak_bytes_.load(std::memory_order_relaxed);
+		while(live > peak &&
+			!m_peak_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+	}
+
+	// 记录一次n字节的回收
+	void record_deallocate(size_type n) {
+		m_deallocations_.fetch_add(1, std::memory_order_relaxed);
+		m_bytes_live_.fetch_sub(n, std::memory_order_relaxed);
+	}
+
+	inline const char *name() const {
+		return m_name_;
+	}
+
+	inline size_type allocations() const {
+		return m_allocations_.load(std::memory_order_relaxed);
+	}
+
+	inline size_type deallocations() const {
+		return m_deallocations_.load(std::memory_order_relaxed);
+	}
+
+	inline size_type bytes_live() const {
+		return m_bytes_live_.load(std::memory_order_relaxed);
+	}
+
+	inline size_type peak_bytes() const {
+		return m_peak_bytes_.load(std::memory_order_relaxed);
+	}
+
+	// 第c个大小类的分配次数
+	inline size_type histogram(size_type c) const {
+		return m_histogram_[c].load(std::memory_order_relaxed);
+	}
+
+	// 重置计数，存活字节数保持不变
+	void reset() {
+		m_allocations_.store(0, std::memory_order_relaxed);
+		m_deallocations_.store(0, std::memory_order_relaxed);
+		m_peak_bytes_.store(bytes_live(), std::memory_order_relaxed);
+		for(size_type i = 0;i < size_class_number;++i) {
+			m_histogram_[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	// 遍历注册表中的全部统计
+	template <typename F>
+	static void for_each(F f) {
+		std::lock_guard<std::mutex> lock(registry_mutex());
+		for(AllocStats *p = registry_head();p != nullptr;p = p->m_next_) {
+			f(static_cast<const AllocStats &>(*p));
+		}
+	}
+
+	// 获取Tag对应的统计，首次使用时注册
+	template <typename Tag>
+	static AllocStats &get() {
+		static AllocStats stats(typeid(Tag).name());
+		return stats;
+	}
+}; // class AllocStats
+
+// 带统计的空间配置器，Tag默认为容器声明的元素类型，元素类型相同的容器需各自传入不同的Tag才能分开统计
+template <typename T, typename Tag = T, typename BASE = Allocator<T>>
+class StatAllocator {
+public:
+	// 定义类型
+	using value_type = typename BASE::value_type;
+	using pointer = typename BASE::pointer;
+	using const_pointer = typename BASE::const_pointer;
+	using reference = typename BASE::reference;
+	using const_reference = typename BASE::const_reference;
+	using size_type = typename BASE::size_type;
+	using difference_type = typename BASE::difference_type;
+
+	using base_type = BASE;
+	using tag_type = Tag;
+
+	// 沿用被包装配置器的对齐保证
+	static constexpr size_type alignment = allocator_traits<BASE>::alignment;
+
+	// 嵌套类型，保留Tag以便汇总到同一记录
+	template <typename U>
+	struct rebind {
+		using other = StatAllocator<U, Tag, typename BASE::template rebind<U>::other>;
+	}; // struct rebind
+
+	template <typename U, typename G, typename B>
+	friend class StatAllocator;
+private:
+	BASE m_base_;
+public:
+	// 构造函数
+	StatAllocator() = default;
+	StatAllocator(const StatAllocator &) = default;
+	~StatAllocator() = default;
+
+	explicit StatAllocator(const BASE &base) :m_base_(base) {
+	}
+
+	template<typename U, typename B>
+	StatAllocator(const StatAllocator<U, Tag, B> &u) :m_base_(u.m_base_) {
+	}
+
+	// 获取对象地址
+	inline pointer address(reference x) const {
+		return m_base_.address(x);
+	}
+
+	inline const_pointer address(const_reference x) const {
+		return m_base_.address(x);
+	}
+
+	// 分配内存空间
+	pointer allocate(size_type n, const void *p = nullptr) {
+		pointer res = m_base_.allocate(n, p);
+		stats().record_allocate(n * sizeof(value_type));
+		return res;
+	}
+
+	// 分配至少容纳n个对象的内存空间，按实际数量记录
+	AllocationResult<pointer> allocate_at_least(size_type n) {
+		AllocationResult<pointer> res = allocator_traits<BASE>::allocate_at_least(m_base_, n);
+		stats().record_allocate(res.count * sizeof(value_type));
+		return res;
+	}
+
+	// 释放内存空间
+	void deallocate(pointer p, size_type n) {
+		stats().record_deallocate(n * sizeof(value_type));
+		m_base_.deallocate(p, n);
+	}
+
+	// 原地扩展内存，成功时按一次回收与一次分配记录
+	bool try_expand(pointer p, size_type old_n, size_type new_n) {
+		if(!allocator_traits<BASE>::try_expand(m_base_, p, old_n, new_n)) {
+			return false;
+		}
+		stats().record_deallocate(old_n * sizeof(value_type));
+		stats().record_allocate(new_n * sizeof(value_type));
+		return true;
+	}
+
+	// 调整内存大小，成功时按一次回收与一次分配记录
+	pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+		pointer res = allocator_traits<BASE>::reallocate(m_base_, p, old_n, new_n);
+		if(res != nullptr) {
+			stats().record_deallocate(old_n * sizeof(value_type));
+			stats().record_allocate(new_n * sizeof(value_type));
+		}
+		return res;
+	}
+
+	// 提示即将逐个分配n个对象
+	void reserve(size_type n) {
+		allocator_traits<BASE>::reserve(m_base_, n);
+	}
+
+	// 对象最大数量
+	size_type max_size() const {
+		return m_base_.max_size();
+	}
+
+	// 使用对应指针进行构造
+	template <typename ... Args>
+	void construct(pointer p, Args&& ... x) {
+		m_base_.construct(p, std::forward<Args>(x)...);
+	}
+
+	// 使用对应指针进行析构
+	void destory(pointer p) {
+		m_base_.destory(p);
+	}
+
+	// 获取被包装的配置器
+	inline const BASE &base() const {
+		return m_base_;
+	}
+
+	// 获取统计记录
+	static inline AllocStats &stats() {
+		return AllocStats::get<Tag>();
+	}
+}; // class StatAllocator
+
+template <typename T, typename Tag, typename BASE>
+constexpr typename StatAllocator<T, Tag, BASE>::size_type StatAllocator<T, Tag, BASE>::alignment;
+
+} // namespace stl
+
+#endif // _ALLOC_STATS_HPP__
@@ -3,10 +3,13 @@
 
 /**
  * 一级空间配置器
- * TODO：通过用户自定义宏判断是否开启二级空间配置器
+ * 定义_TINY_STL_MEMORY_POOL_宏时，不超过Alloc::max_block_size的请求交由二级空间配置器处理
+ * 定义_TINY_STL_MMAP_ALLOC_宏时，不小于MmapAlloc::mmap_threshold的请求直接使用mmap
 */
 
 #include <new>
+#include <utility>
+#include <cstddef>
 
 #include <stdint.h>
 
@@ -15,8 +18,20 @@
 #include "alloc.hpp"
 #endif // _TINY_STL_MEMORY_POOL_
 
+#ifdef _TINY_STL_MMAP_ALLOC_
+// 大块内存配置器头文件
+#include "mmap_alloc.hpp"
+#endif // _TINY_STL_MMAP_ALLOC_
+
 namespace stl {
 
+// allocate_at_least的结果，count为实际可容纳的对象数量
+template <typename P>
+struct AllocationResult {
+	P ptr;
+	size_t count;
+}; // struct AllocationResult
+
 template <typename T>
 class Allocator {
 private:
@@ -61,6 +76,12 @@ private:
 	Alloc m_alloc_;
 #endif
 
+#ifdef _TINY_STL_MMAP_ALLOC_
+private:
+	// 大块内存配置器实例
+	MmapAlloc m_mmap_alloc_;
+#endif
+
 public:
 	// 构造函数
 	Allocator() = default;
@@ -82,15 +103,89 @@ public:
 
 	// 分配内存空间
 	pointer allocate(size_type n, const void *p = nullptr) {
+#ifdef _TINY_STL_MEMORY_POOL_
+		if(n * sizeof(value_type) <= Alloc::max_block_size) {
+			return static_cast<pointer>(m_alloc_.allocate(n * sizeof(value_type), p));
+		}
+#endif
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(n * sizeof(value_type) >= MmapAlloc::mmap_threshold) {
+			return static_cast<pointer>(m_mmap_alloc_.allocate(n * sizeof(value_type), p));
+		}
+#endif
 		std::set_new_handler(nullptr);
 		return static_cast<pointer>(::operator new(n * sizeof(value_type)));
 	}
 
+	// 分配至少容纳n个对象的内存空间，返回实际可容纳的数量，回收时可使用该数量
+	AllocationResult<pointer> allocate_at_least(size_type n) {
+		size_type count = n;
+#ifdef _TINY_STL_MEMORY_POOL_
+		if(n * sizeof(value_type) <= Alloc::max_block_size) {
+			count = Alloc::usable_size(n * sizeof(value_type)) / sizeof(value_type);
+		}
+#endif
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(n * sizeof(value_type) >= MmapAlloc::mmap_threshold) {
+			count = MmapAlloc::mapped_size(n * sizeof(value_type)) / sizeof(value_type);
+		}
+#endif
+		return AllocationResult<pointer>{ allocate(n), count };
+	}
+
 	// 释放内存空间
 	void deallocate(pointer p, size_type n) {
+#ifdef _TINY_STL_MEMORY_POOL_
+		if(n * sizeof(value_type) <= Alloc::max_block_size) {
+			m_alloc_.deallocate(p, n * sizeof(value_type));
+			return;
+		}
+#endif
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(n * sizeof(value_type) >= MmapAlloc::mmap_threshold) {
+			m_mmap_alloc_.deallocate(p, n * sizeof(value_type));
+			return;
+		}
+#endif
 		::operator delete(p);
 	}
 
+	// 将容纳old_n个对象的内存原地扩展为容纳new_n个对象，地址不变，失败返回false
+	bool try_expand(pointer p, size_type old_n, size_type new_n) {
+#ifdef _TINY_STL_MEMORY_POOL_
+		if(old_n * sizeof(value_type) <= Alloc::max_block_size) {
+			return new_n * sizeof(value_type) <= Alloc::max_block_size &&
+				m_alloc_.expand(p, old_n * sizeof(value_type), new_n * sizeof(value_type));
+		}
+#endif
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(old_n * sizeof(value_type) >= MmapAlloc::mmap_threshold &&
+			new_n * sizeof(value_type) >= MmapAlloc::mmap_threshold) {
+			return m_mmap_alloc_.expand(p, old_n * sizeof(value_type), new_n * sizeof(value_type));
+		}
+#endif
+		(void)p;
+		(void)old_n;
+		(void)new_n;
+		return false;
+	}
+
+	// 将容纳old_n个对象的内存调整为容纳new_n个对象，内容按字节保留，
+	// 仅适用于可按位搬移的类型，无法原地调整时返回nullptr
+	pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+#ifdef _TINY_STL_MMAP_ALLOC_
+		if(old_n * sizeof(value_type) >= MmapAlloc::mmap_threshold &&
+			new_n * sizeof(value_type) >= MmapAlloc::mmap_threshold) {
+			return static_cast<pointer>(m_mmap_alloc_.reallocate(p,
+				old_n * sizeof(value_type), new_n * sizeof(value_type)));
+		}
+#endif
+		(void)p;
+		(void)old_n;
+		(void)new_n;
+		return nullptr;
+	}
+
 	// 对象最大数量
 	size_type max_size() const {
 		return static_cast<size_type>(UINT32_MAX / sizeof(value_type));
@@ -108,6 +203,93 @@ public:
 	}
 }; // class Allocator
 
+// 配置器声明alignment时使用该值，否则为元素类型的对齐值，且不超过::operator new的保证
+template <typename ALLOC>
+constexpr auto __allocator_alignment(int) -> decltype(ALLOC::alignment, size_t()) {
+	return ALLOC::alignment;
+}
+
+template <typename ALLOC>
+constexpr size_t __allocator_alignment(long) {
+	return alignof(typename ALLOC::value_type) < alignof(std::max_align_t) ?
+		alignof(typename ALLOC::value_type) : alignof(std::max_align_t);
+}
+
+// 萃取空间配置器的可选操作
+template <typename ALLOC>
+struct allocator_traits {
+	using pointer = typename ALLOC::pointer;
+	using size_type = typename ALLOC::size_type;
+
+	// 分配所得内存起始地址的对齐保证
+	static constexpr size_type alignment = __allocator_alignment<ALLOC>(0);
+private:
+	template <typename A>
+	static auto __reallocate(A &a, pointer p, size_type old_n, size_type new_n, int)
+		-> decltype(a.reallocate(p, old_n, new_n)) {
+		return a.reallocate(p, old_n, new_n);
+	}
+
+	template <typename A>
+	static pointer __reallocate(A &, pointer, size_type, size_type, long) {
+		return nullptr;
+	}
+
+	template <typename A>
+	static auto __allocate_at_least(A &a, size_type n, int)
+		-> decltype(a.allocate_at_least(n)) {
+		return a.allocate_at_least(n);
+	}
+
+	template <typename A>
+	static AllocationResult<pointer> __allocate_at_least(A &a, size_type n, long) {
+		return AllocationResult<pointer>{ a.allocate(n), n };
+	}
+
+	template <typename A>
+	static auto __try_expand(A &a, pointer p, size_type old_n, size_type new_n, int)
+		-> decltype(a.try_expand(p, old_n, new_n)) {
+		return a.try_expand(p, old_n, new_n);
+	}
+
+	template <typename A>
+	static bool __try_expand(A &, pointer, size_type, size_type, long) {
+		return false;
+	}
+
+	template <typename A>
+	static auto __reserve(A &a, size_type n, int) -> decltype(a.reserve(n)) {
+		return a.reserve(n);
+	}
+
+	template <typename A>
+	static void __reserve(A &, size_type, long) {
+	}
+public:
+	// 提示即将逐个分配n个对象，配置器支持时预先批量备好
+	static inline void reserve(ALLOC &a, size_type n) {
+		__reserve(a, n, 0);
+	}
+
+	// 分配至少容纳n个对象的内存，配置器不支持时恰好分配n个
+	static inline AllocationResult<pointer> allocate_at_least(ALLOC &a, size_type n) {
+		return __allocate_at_least(a, n, 0);
+	}
+
+	// 原地扩展内存，地址不变，配置器不支持或无法扩展时返回false
+	static inline bool try_expand(ALLOC &a, pointer p, size_type old_n, size_type new_n) {
+		return __try_expand(a, p, old_n, new_n, 0);
+	}
+
+	// 调整内存大小，配置器不支持或无法调整时返回nullptr
+	static inline pointer reallocate(ALLOC &a, pointer p, size_type old_n, size_type new_n) {
+		return __reallocate(a, p, old_n, new_n, 0);
+	}
+}; // struct allocator_traits
+
+template <typename ALLOC>
+constexpr typename allocator_traits<ALLOC>::size_type allocator_traits<ALLOC>::alignment;
+
 } // namespace stl
 
 #endif // _ALLOCATOR_HPP__
\ No newline at end of file
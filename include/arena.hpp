@@ -0,0 +1,276 @@
+#ifndef _ARENA_HPP__
+#define _ARENA_HPP__
+
+/**
+ * 单调增长的区域配置器
+ * 内存以指针递增方式分配，单独的回收操作不归还内存，
+ * 通过检查点一次性回退检查点之后分配的全部内存
+*/
+
+#include <new>
+#include <utility>
+#include <cstddef>
+
+#include <stdint.h>
+
+#include <cassert>
+
+namespace stl {
+
+class Arena {
+public:
+	using size_type = size_t;
+	using difference_type = ::ptrdiff_t;
+
+	static constexpr size_type default_block_size = 4096;
+private:
+	// 内存块头部，内存块按申请顺序组成单链表
+	struct Block {
+		Block *m_next_;
+		size_type m_size_;
+
+		inline char *begin() {
+			return reinterpret_cast<char *>(this + 1);
+		}
+
+		inline char *end() {
+			return begin() + m_size_;
+		}
+	}; // struct Block
+
+	Block *m_first_;
+	Block *m_current_;
+	char *m_cur_;
+	char *m_end_;
+	size_type m_block_size_;
+
+	// 对齐指针
+	static inline char *align_up(char *p, size_type align) {
+		return reinterpret_cast<char *>(
+			(reinterpret_cast<uintptr_t>(p) + align - 1) & ~static_cast<uintptr_t>(align - 1));
+	}
+
+	// 切换到能容纳n字节的下一个内存块，优先复用回退后保留的内存块
+	void next_block(size_type n, size_type align) {
+		size_type need = n + align;
+		Block *next = m_current_ == nullptr ? m_first_ : m_current_->m_next_;
+		if(next == nullptr || next->m_size_ < need) {
+			size_type size = m_block_size_;
+			while(size < need) {
+				size <<= 1;
+			}
+			Block *block = static_cast<Block *>(::operator new(sizeof(Block) + size));
+			block->m_size_ = size;
+			block->m_next_ = next;
+			if(m_current_ == nullptr) {
+				m_first_ = block;
+			} else {
+				m_current_->m_next_ = block;
+			}
+			next = block;
+		}
+		m_current_ = next;
+		m_cur_ = next->begin();
+		m_end_ = next->end();
+	}
+public:
+	// 检查点，记录当前内存块及分配位置
+	class Checkpoint {
+		friend class Arena;
+
+		Block *m_block_;
+		char *m_cur_;
+
+		Checkpoint(Block *block, char *cur) :m_block_(block), m_cur_(cur) {
+		}
+	}; // class Checkpoint
+
+	explicit Arena(size_type block_size = default_block_size) :
+		m_first_(nullptr),
+		m_current_(nullptr),
+		m_cur_(nullptr),
+		m_end_(nullptr),
+		m_block_size_(block_size) {
+		assert(block_size > 0);
+	}
+
+	Arena(const Arena &) = delete;
+	Arena &operator=(const Arena &) = delete;
+
+	~Arena() {
+		release();
+	}
+
+	// 分配n字节内存，按align对齐
+	inline void *allocate(size_type n, size_type align = alignof(std::max_align_t)) {
+		char *p = align_up(m_cur_, align);
+		if(m_cur_ == nullptr || p + n > m_end_) {
+			next_block(n, align);
+			p = align_up(m_cur_, align);
+		}
+		m_cur_ = p + n;
+		return p;
+	}
+
+	// 回收n字节内存，仅最后一次分配的内存可被立即复用
+	inline void deallocate(void *p, size_type n) {
+		if(static_cast<char *>(p) + n == m_cur_) {
+			m_cur_ = static_cast<char *>(p);
+		}
+	}
+
+	// 获取当前检查点
+	inline Checkpoint checkpoint() const {
+		return Checkpoint(m_current_, m_cur_);
+	}
+
+	// 回退到检查点，检查点之后分配的内存全部失效，内存块保留以便复用
+	inline void rewind(const Checkpoint &cp) {
+		if(cp.m_block_ == nullptr) {
+			reset();
+			return;
+		}
+		m_current_ = cp.m_block_;
+		m_cur_ = cp.m_cur_;
+		m_end_ = m_current_->end();
+	}
+
+	// 回退到初始状态，保留全部内存块
+	inline void reset() {
+		m_current_ = nullptr;
+		m_cur_ = nullptr;
+		m_end_ = nullptr;
+	}
+
+	// 释放全部内存块
+	void release() {
+		while(m_first_ != nullptr) {
+			Block *next = m_first_->m_next_;
+			::operator delete(m_first_);
+			m_first_ = next;
+		}
+		reset();
+	}
+
+	// 当前线程默认使用的区域，由ArenaScope设置
+	static inline Arena *&current() {
+		static thread_local Arena *arena = nullptr;
+		return arena;
+	}
+}; // class Arena
+
+// 作用域检查点，构造时将区域设为当前线程默认区域并记录检查点，析构时回退并恢复
+class ArenaScope {
+	Arena &m_arena_;
+	Arena *m_prev_;
+	Arena::Checkpoint m_checkpoint_;
+public:
+	explicit ArenaScope(Arena &arena) :
+		m_arena_(arena),
+		m_prev_(Arena::current()),
+		m_checkpoint_(arena.checkpoint()) {
+		Arena::current() = &arena;
+	}
+
+	ArenaScope(const ArenaScope &) = delete;
+	ArenaScope &operator=(const ArenaScope &) = delete;
+
+	~ArenaScope() {
+		m_arena_.rewind(m_checkpoint_);
+		Arena::current() = m_prev_;
+	}
+}; // class ArenaScope
+
+// 区域空间配置器，默认构造时绑定当前线程的默认区域
+template <typename T>
+class ArenaAllocator {
+public:
+	// 定义类型
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = size_t;
+	using difference_type = ::ptrdiff_t;
+
+	// 嵌套类型
+	template <typename U>
+	struct rebind {
+		using other = ArenaAllocator<U>;
+	}; // struct rebind
+
+	template <typename U>
+	friend class ArenaAllocator;
+private:
+	Arena *m_arena_;
+public:
+	// 构造函数
+	ArenaAllocator() :m_arena_(Arena::current()) {
+		assert(m_arena_ != nullptr);
+	}
+
+	explicit ArenaAllocator(Arena &arena) :m_arena_(&arena) {
+	}
+
+	ArenaAllocator(const ArenaAllocator &) = default;
+	~ArenaAllocator() = default;
+
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U> &u) :m_arena_(u.m_arena_) {
+	}
+
+	// 获取对象地址
+	inline pointer address(reference x) const {
+		return static_cast<pointer>(&x);
+	}
+
+	inline const_pointer address(const_reference x) const {
+		return static_cast<const_pointer>(&x);
+	}
+
+	// 分配内存空间
+	pointer allocate(size_type n, const void * = nullptr) {
+		return static_cast<pointer>(m_arena_->allocate(n * sizeof(value_type), alignof(value_type)));
+	}
+
+	// 释放内存空间，内存在区域回退时统一回收
+	void deallocate(pointer p, size_type n) {
+		m_arena_->deallocate(p, n * sizeof(value_type));
+	}
+
+	// 对象最大数量
+	size_type max_size() const {
+		return static_cast<size_type>(UINT32_MAX / sizeof(value_type));
+	}
+
+	// 使用对应指针进行构造
+	template <typename ... Args>
+	void construct(pointer p, Args&& ... x) {
+		new(p) value_type(std::forward<Args>(x)...);
+	}
+
+	// 使用对应指针进行析构
+	void destory(pointer p) {
+		p->~value_type();
+	}
+
+	// 获取绑定的区域
+	inline Arena *arena() const {
+		return m_arena_;
+	}
+}; // class ArenaAllocator
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.arena() != b.arena();
+}
+
+} // namespace stl
+
+#endif // _ARENA_HPP__
@@ -8,7 +8,8 @@
 
 namespace stl {
 
-template <typename T, size_t m_size_>
+// Align指定内部存储的对齐值，默认为元素类型的对齐值
+template <typename T, size_t m_size_, size_t Align = alignof(T)>
 struct Array {
 public:
 	using value_type = T;
@@ -23,8 +24,11 @@ public:
 	using const_iterator = const iterator;
 	using reverse_iterator = ReverseIterator<iterator>;
 	using const_reverse_iterator = const ReverseIterator<iterator>;
+
+	// data()返回地址的对齐保证
+	static constexpr size_type data_alignment = Align < alignof(T) ? alignof(T) : Align;
 private:
-	T m_array_[m_size_];
+	alignas(data_alignment) T m_array_[m_size_];
 public:
 	inline reference at(size_type pos) {
 		return m_array_[pos];
@@ -112,13 +116,16 @@ public:
 		}
 	}
 
-	void swap(Array<T, m_size_> &array) {
+	void swap(Array<T, m_size_, Align> &array) {
 		for(size_type i = 0;i < m_size_;++i) {
 			stl::swap(at(i), array.at(i));
 		}
 	}
 };
 
+template <typename T, size_t m_size_, size_t Align>
+constexpr size_t Array<T, m_size_, Align>::data_alignment;
+
 } // namespace stl
 
 
@@ -0,0 +1,425 @@
+#ifndef _BIT_ITERATOR_HPP__
+#define _BIT_ITERATOR_HPP__
+
+/**
+ * 位迭代器与按字处理的算法
+ * 按位压缩存储的布尔序列以64位字为单位，迭代器由字指针与字内偏移组成，
+ * count、find、fill、fill_n与有序区间的集合算法对位迭代器重载，每次处理一个字
+*/
+
+#include <cstddef>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "algobase.hpp"
+
+namespace stl {
+
+using bit_word = uint64_t;
+
+// 每个字的位数
+static constexpr size_t bit_word_size = 64;
+
+namespace {
+
+// 字内[from, to)位为1的掩码，0 <= from < to <= 64
+inline bit_word __bit_mask(size_t from, size_t to) {
+	return (~bit_word(0) >> (bit_word_size - (to - from))) << from;
+}
+
+inline size_t __bit_popcount(bit_word w) {
+#ifdef __GNUC__
+	return static_cast<size_t>(__builtin_popcountll(w));
+#else
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+	return static_cast<size_t>((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// w不为0
+inline size_t __bit_ctz(bit_word w) {
+#ifdef __GNUC__
+	return static_cast<size_t>(__builtin_ctzll(w));
+#else
+	return __bit_popcount((w & -w) - 1);
+#endif
+}
+
+} // namespace
+
+// 单个位的代理引用
+class BitReference {
+private:
+	bit_word *m_word_;
+	bit_word m_mask_;
+public:
+	BitReference(bit_word *word, bit_word mask) :m_word_(word), m_mask_(mask) {
+	}
+
+	inline operator bool() const {
+		return (*m_word_ & m_mask_) != 0;
+	}
+
+	inline BitReference &operator=(bool x) {
+		if(x) {
+			*m_word_ |= m_mask_;
+		} else {
+			*m_word_ &= ~m_mask_;
+		}
+		return *this;
+	}
+
+	inline BitReference &operator=(const BitReference &r) {
+		return *this = bool(r);
+	}
+
+	inline bool operator~() const {
+		return !bool(*this);
+	}
+
+	inline void flip() {
+		*m_word_ ^= m_mask_;
+	}
+}; // class BitReference
+
+inline void swap(BitReference a, BitReference b) {
+	bool tmp = a;
+	a = bool(b);
+	b = tmp;
+}
+
+// Const为true时为常量迭代器，解引用得到bool
+template <bool Const>
+class BitIterator {
+public:
+	using iterator_category = random_access_iterator_tag;
+	using value_type = bool;
+	using difference_type = ::ptrdiff_t;
+	using size_type = size_t;
+	using pointer = void;
+	using reference = typename IfThenElse<Const, bool, BitReference>::result;
+
+	using word_pointer = typename IfThenElse<Const, const bit_word *, bit_word *>::result;
+	using self = BitIterator<Const>;
+private:
+	word_pointer m_word_;
+	size_type m_offset_;
+
+	inline bool dereference(true_type) const {
+		return (*m_word_ >> m_offset_) & 1;
+	}
+
+	inline BitReference dereference(false_type) const {
+		return BitReference(m_word_, bit_word(1) << m_offset_);
+	}
+public:
+	explicit BitIterator(word_pointer word = nullptr, size_type offset = 0) :
+		m_word_(word), m_offset_(offset) {
+	}
+
+	// 可转换为常量迭代器
+	inline operator BitIterator<true>() const {
+		return BitIterator<true>(m_word_, m_offset_);
+	}
+
+	// 所在的字与字内偏移
+	inline word_pointer word() const {
+		return m_word_;
+	}
+
+	inline size_type offset() const {
+		return m_offset_;
+	}
+
+	inline reference operator*() const {
+		return dereference(bool_type<Const>());
+	}
+
+	inline reference operator[](difference_type n) const {
+		return *(*this + n);
+	}
+
+	inline difference_type operator-(const self &b) const {
+		return (m_word_ - b.m_word_) * static_cast<difference_type>(bit_word_size) +
+			static_cast<difference_type>(m_offset_) - static_cast<difference_type>(b.m_offset_);
+	}
+
+	inline bool operator==(const self &b) const {
+		return m_word_ == b.m_word_ && m_offset_ == b.m_offset_;
+	}
+
+	inline bool operator!=(const self &b) const {
+		return !operator==(b);
+	}
+
+	inline bool operator<(const self &b) const {
+		return m_word_ < b.m_word_ || (m_word_ == b.m_word_ && m_offset_ < b.m_offset_);
+	}
+
+	inline bool operator>(const self &b) const {
+		return b < *this;
+	}
+
+	inline bool operator<=(const self &b) const {
+		return !(b < *this);
+	}
+
+	inline bool operator>=(const self &b) const {
+		return !(*this < b);
+	}
+
+	inline self &operator+=(difference_type n) {
+		difference_type off = n + static_cast<difference_type>(m_offset_);
+		difference_type word_off = off >= 0 ? off / static_cast<difference_type>(bit_word_size) :
+			-((-off - 1) / static_cast<difference_type>(bit_word_size)) - 1;
+		m_word_ += word_off;
+		m_offset_ = static_cast<size_type>(off - word_off * static_cast<difference_type>(bit_word_size));
+		return *this;
+	}
+
+	inline self &operator-=(difference_type n) {
+		return *this += -n;
+	}
+
+	inline self operator+(difference_type n) const {
+		self s = *this;
+		return s += n;
+	}
+
+	inline self operator-(difference_type n) const {
+		self s = *this;
+		return s -= n;
+	}
+
+	inline self &operator++() {
+		if(++m_offset_ == bit_word_size) {
+			m_offset_ = 0;
+			++m_word_;
+		}
+		return *this;
+	}
+
+	inline self operator++(int) {
+		self s = *this;
+		++*this;
+		return s;
+	}
+
+	inline self &operator--() {
+		if(m_offset_-- == 0) {
+			m_offset_ = bit_word_size - 1;
+			--m_word_;
+		}
+		return *this;
+	}
+
+	inline self operator--(int) {
+		self s = *this;
+		--*this;
+		return s;
+	}
+}; // class BitIterator
+
+namespace {
+
+// 自word的off位起读取n位，0 < n <= 64
+inline bit_word __bit_load(const bit_word *word, size_t off, size_t n) {
+	bit_word v = word[0] >> off;
+	if(off + n > bit_word_size) {
+		v |= word[1] << (bit_word_size - off);
+	}
+	return n == bit_word_size ? v : v & __bit_mask(0, n);
+}
+
+// 将v的低n位写入word的[off, off + n)位，off + n <= 64
+inline void __bit_store(bit_word *word, size_t off, size_t n, bit_word v) {
+	bit_word mask = __bit_mask(off, off + n);
+	*word = (*word & ~mask) | ((v << off) & mask);
+}
+
+// 区间[first, last)中值为1的位数
+template <bool C>
+size_t __bit_count(BitIterator<C> first, BitIterator<C> last) {
+	auto w = first.word();
+	if(w == last.word()) {
+		return first.offset() == last.offset() ? 0 :
+			__bit_popcount(*w & __bit_mask(first.offset(), last.offset()));
+	}
+	size_t n = __bit_popcount(*w & __bit_mask(first.offset(), bit_word_size));
+	for(++w;w != last.word();++w) {
+		n += __bit_popcount(*w);
+	}
+	if(last.offset() != 0) {
+		n += __bit_popcount(*w & __bit_mask(0, last.offset()));
+	}
+	return n;
+}
+
+// 将区间[first, last)的位置为value
+inline void __bit_fill(BitIterator<false> first, BitIterator<false> last, bool value) {
+	auto w = first.word();
+	auto store = [value](bit_word *p, bit_word mask) {
+		*p = value ? (*p | mask) : (*p & ~mask);
+	};
+	if(w == last.word()) {
+		if(first.offset() != last.offset()) {
+			store(w, __bit_mask(first.offset(), last.offset()));
+		}
+		return;
+	}
+	if(first.offset() != 0) {
+		store(w, __bit_mask(first.offset(), bit_word_size));
+		++w;
+	}
+	if(last.word() != w) {
+		::memset(static_cast<void *>(w), value ? 0xff : 0, (last.word() - w) * sizeof(bit_word));
+	}
+	if(last.offset() != 0) {
+		store(last.word(), __bit_mask(0, last.offset()));
+	}
+}
+
+} // namespace
+
+// 复制位区间，每次至多处理一个字，目标区间位于源区间之前或不重叠
+template <bool C>
+BitIterator<false> bit_copy(BitIterator<C> first, BitIterator<C> last, BitIterator<false> result) {
+	size_t n = static_cast<size_t>(last - first);
+	while(n > 0) {
+		size_t k = bit_word_size - result.offset();
+		k = k < n ? k : n;
+		__bit_store(result.word(), result.offset(), k, __bit_load(first.word(), first.offset(), k));
+		first += k;
+		result += k;
+		n -= k;
+	}
+	return result;
+}
+
+// 自尾部向前复制位区间，目标区间位于源区间之后或不重叠
+template <bool C>
+BitIterator<false> bit_copy_backward(BitIterator<C> first, BitIterator<C> last, BitIterator<false> result) {
+	size_t n = static_cast<size_t>(last - first);
+	while(n > 0) {
+		size_t k = result.offset() == 0 ? bit_word_size : result.offset();
+		k = k < n ? k : n;
+		last -= k;
+		result -= k;
+		__bit_store(result.word(), result.offset(), k, __bit_load(last.word(), last.offset(), k));
+		n -= k;
+	}
+	return result;
+}
+
+template <bool C, typename T>
+::ptrdiff_t count(BitIterator<C> first, BitIterator<C> last, T value) {
+	size_t ones = __bit_count(first, last);
+	return static_cast<::ptrdiff_t>(value ? ones : static_cast<size_t>(last - first) - ones);
+}
+
+// 逐字查找首个与value相同的位，以ctz定位
+template <bool C, typename T>
+BitIterator<C> find(BitIterator<C> first, BitIterator<C> last, const T &value) {
+	if(first == last) {
+		return last;
+	}
+	bit_word flip = value ? 0 : ~bit_word(0);
+	auto w = first.word();
+	bit_word bits = (*w ^ flip) & __bit_mask(first.offset(), bit_word_size);
+	while(w != last.word()) {
+		if(bits != 0) {
+			return BitIterator<C>(w, __bit_ctz(bits));
+		}
+		++w;
+		if(w == last.word() && last.offset() == 0) {
+			return last;
+		}
+		bits = *w ^ flip;
+	}
+	bits &= __bit_mask(0, last.offset());
+	return bits != 0 ? BitIterator<C>(w, __bit_ctz(bits)) : last;
+}
+
+template <typename T>
+void fill(BitIterator<false> first, BitIterator<false> last, T value) {
+	__bit_fill(first, last, static_cast<bool>(value));
+}
+
+template <typename Size, typename T>
+BitIterator<false> fill_n(BitIterator<false> first, Size size, T value) {
+	auto last = first + static_cast<::ptrdiff_t>(size);
+	__bit_fill(first, last, static_cast<bool>(value));
+	return last;
+}
+
+// 有序的布尔区间由false与true的数量唯一确定，集合算法仅需统计数量后填充结果
+namespace {
+
+template <typename OutputIterator>
+OutputIterator __bit_emit(OutputIterator result, size_t zeros, size_t ones) {
+	result = stl::fill_n(result, zeros, false);
+	return stl::fill_n(result, ones, true);
+}
+
+inline size_t __bit_max(size_t a, size_t b) {
+	return a < b ? b : a;
+}
+
+inline size_t __bit_min(size_t a, size_t b) {
+	return a < b ? a : b;
+}
+
+inline size_t __bit_sub(size_t a, size_t b) {
+	return a < b ? 0 : a - b;
+}
+
+} // namespace
+
+template <bool C1, bool C2, typename OutputIterator>
+OutputIterator set_union(BitIterator<C1> first1, BitIterator<C1> last1,
+	BitIterator<C2> first2, BitIterator<C2> last2, OutputIterator d_first) {
+	size_t o1 = __bit_count(first1, last1), o2 = __bit_count(first2, last2);
+	size_t z1 = static_cast<size_t>(last1 - first1) - o1, z2 = static_cast<size_t>(last2 - first2) - o2;
+	return __bit_emit(d_first, __bit_max(z1, z2), __bit_max(o1, o2));
+}
+
+template <bool C1, bool C2, typename OutputIterator>
+OutputIterator set_intersection(BitIterator<C1> first1, BitIterator<C1> last1,
+	BitIterator<C2> first2, BitIterator<C2> last2, OutputIterator d_first) {
+	size_t o1 = __bit_count(first1, last1), o2 = __bit_count(first2, last2);
+	size_t z1 = static_cast<size_t>(last1 - first1) - o1, z2 = static_cast<size_t>(last2 - first2) - o2;
+	return __bit_emit(d_first, __bit_min(z1, z2), __bit_min(o1, o2));
+}
+
+template <bool C1, bool C2, typename OutputIterator>
+OutputIterator set_difference(BitIterator<C1> first1, BitIterator<C1> last1,
+	BitIterator<C2> first2, BitIterator<C2> last2, OutputIterator d_first) {
+	size_t o1 = __bit_count(first1, last1), o2 = __bit_count(first2, last2);
+	size_t z1 = static_cast<size_t>(last1 - first1) - o1, z2 = static_cast<size_t>(last2 - first2) - o2;
+	return __bit_emit(d_first, __bit_sub(z1, z2), __bit_sub(o1, o2));
+}
+
+template <bool C1, bool C2, typename OutputIterator>
+OutputIterator set_symmetric_difference(BitIterator<C1> first1, BitIterator<C1> last1,
+	BitIterator<C2> first2, BitIterator<C2> last2, OutputIterator d_first) {
+	size_t o1 = __bit_count(first1, last1), o2 = __bit_count(first2, last2);
+	size_t z1 = static_cast<size_t>(last1 - first1) - o1, z2 = static_cast<size_t>(last2 - first2) - o2;
+	return __bit_emit(d_first, __bit_sub(z1, z2) + __bit_sub(z2, z1), __bit_sub(o1, o2) + __bit_sub(o2, o1));
+}
+
+template <bool C1, bool C2>
+bool include(BitIterator<C1> first1, BitIterator<C1> last1,
+	BitIterator<C2> first2, BitIterator<C2> last2) {
+	size_t o1 = __bit_count(first1, last1), o2 = __bit_count(first2, last2);
+	size_t z1 = static_cast<size_t>(last1 - first1) - o1, z2 = static_cast<size_t>(last2 - first2) - o2;
+	return o2 <= o1 && z2 <= z1;
+}
+
+} // namespace stl
+
+#endif // _BIT_ITERATOR_HPP__
@@ -0,0 +1,444 @@
+#ifndef _BIT_VECTOR_HPP__
+#define _BIT_VECTOR_HPP__
+
+/**
+ * Vector<bool>的按位压缩特化
+ * 每个元素占1位，以64位字存储，经由代理引用BitReference访问，
+ * 字内超出size()的位内容未定，各操作均按掩码忽略
+*/
+
+#include <string.h>
+
+#include "vector.hpp"
+#include "bit_iterator.hpp"
+
+namespace stl {
+
+template <typename ALLOCATOR, typename GROWTH>
+class Vector<bool, ALLOCATOR, GROWTH> {
+public:
+	using value_type = bool;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = BitReference;
+	using const_reference = bool;
+	using pointer = void;
+	using const_pointer = void;
+
+	using iterator = BitIterator<false>;
+	using const_iterator = BitIterator<true>;
+	using reverse_iterator = ReverseIterator<iterator>;
+	using const_reverse_iterator = ReverseIterator<const_iterator>;
+
+	using word_type = bit_word;
+	using word_pointer = word_type *;
+	using const_word_pointer = const word_type *;
+private:
+	using word_allocator = typename ALLOCATOR::template rebind<word_type>::other;
+
+	word_allocator m_allocator_;
+
+	word_pointer m_words_;
+	size_type m_size_;
+	// 以字计的容量
+	size_type m_word_capacity_;
+
+	// 容纳n位所需的字数
+	static inline size_type word_number(size_type n) {
+		return (n + bit_word_size - 1) / bit_word_size;
+	}
+
+	// 获取容纳n位应分配的字数，由扩容策略决定
+	size_type new_memory(size_type n) {
+		return GROWTH::grow(m_word_capacity_, word_number(n), sizeof(word_type));
+	}
+
+	// 换用容量为ncap个字的新内存，保留前size()位
+	void reallocate_words(size_type ncap) {
+		AllocationResult<word_pointer> res = allocator_traits<word_allocator>::allocate_at_least(m_allocator_, ncap);
+		size_type used = word_number(m_size_);
+		if(used != 0) {
+			::memcpy(static_cast<void *>(res.ptr), static_cast<const void *>(m_words_), used * sizeof(word_type));
+		}
+		release();
+		m_words_ = res.ptr;
+		m_word_capacity_ = res.count;
+	}
+
+	void release() {
+		if(m_words_ != nullptr) {
+			m_allocator_.deallocate(m_words_, m_word_capacity_);
+		}
+	}
+
+	// 在下标pos处留出n位的空隙，空隙内容未定
+	iterator make_gap(size_type pos, size_type n) {
+		size_type si = m_size_;
+		if(si + n > capacity()) {
+			size_type ncap = new_memory(si + n);
+			AllocationResult<word_pointer> res = allocator_traits<word_allocator>::allocate_at_least(m_allocator_, ncap);
+			iterator p(res.ptr, 0);
+			if(pos != 0) {
+				::memcpy(static_cast<void *>(res.ptr), static_cast<const void *>(m_words_),
+					word_number(pos) * sizeof(word_type));
+			}
+			bit_copy(cbegin() + pos, cend(), p + (pos + n));
+			release();
+			m_words_ = res.ptr;
+			m_word_capacity_ = res.count;
+		} else {
+			bit_copy_backward(cbegin() + pos, cend(), end() + n);
+		}
+		m_size_ += n;
+		return begin() + pos;
+	}
+
+	template <typename I>
+	iterator insert(iterator pos, I first, I last, input_iterator_tag) {
+		size_type dis = pos - begin();
+		for(;first != last;++first, ++pos) {
+			pos = insert(pos, static_cast<bool>(*first));
+		}
+		return begin() + dis;
+	}
+
+	template <typename I>
+	iterator insert(iterator pos, I first, I last, forward_iterator_tag) {
+		size_type n = stl::distance(first, last);
+		auto p = make_gap(pos - begin(), n);
+		for(auto q = p;first != last;++first, ++q) {
+			*q = static_cast<bool>(*first);
+		}
+		return p;
+	}
+public:
+	Vector() :
+		m_words_(nullptr),
+		m_size_(0),
+		m_word_capacity_(0) {
+	}
+
+	explicit Vector(const ALLOCATOR &allocator) :
+		m_allocator_(allocator),
+		m_words_(nullptr),
+		m_size_(0),
+		m_word_capacity_(0) {
+	}
+
+	explicit Vector(size_type n, bool x = false) :
+		m_words_(nullptr),
+		m_size_(0),
+		m_word_capacity_(0) {
+		resize(n, x);
+	}
+
+	template <typename InputIterator>
+	explicit Vector(InputIterator first, InputIterator last) :
+		m_words_(nullptr),
+		m_size_(0),
+		m_word_capacity_(0) {
+		insert(end(), first, last);
+	}
+
+	Vector(const Vector &v) :
+		m_allocator_(v.m_allocator_),
+		m_words_(nullptr),
+		m_size_(0),
+		m_word_capacity_(0) {
+		if(v.m_size_ != 0) {
+			reallocate_words(word_number(v.m_size_));
+			::memcpy(static_cast<void *>(m_words_), static_cast<const void *>(v.m_words_),
+				word_number(v.m_size_) * sizeof(word_type));
+			m_size_ = v.m_size_;
+		}
+	}
+
+	Vector(Vector &&v) noexcept :
+		m_allocator_(v.m_allocator_),
+		m_words_(v.m_words_),
+		m_size_(v.m_size_),
+		m_word_capacity_(v.m_word_capacity_) {
+		v.m_words_ = nullptr;
+		v.m_size_ = 0;
+		v.m_word_capacity_ = 0;
+	}
+
+	~Vector() {
+		release();
+	}
+
+	inline Vector &operator=(const Vector &v) {
+		if(this != &v) {
+			m_size_ = 0;
+			if(word_number(v.m_size_) > m_word_capacity_) {
+				reallocate_words(word_number(v.m_size_));
+			}
+			if(v.m_size_ != 0) {
+				::memcpy(static_cast<void *>(m_words_), static_cast<const void *>(v.m_words_),
+					word_number(v.m_size_) * sizeof(word_type));
+			}
+			m_size_ = v.m_size_;
+		}
+		return *this;
+	}
+
+	inline Vector &operator=(Vector &&v) {
+		if(this != &v) {
+			release();
+
+			m_allocator_ = v.m_allocator_;
+			m_words_ = v.m_words_;
+			m_size_ = v.m_size_;
+			m_word_capacity_ = v.m_word_capacity_;
+
+			v.m_words_ = nullptr;
+			v.m_size_ = 0;
+			v.m_word_capacity_ = 0;
+		}
+		return *this;
+	}
+
+	void swap(Vector &v) {
+		if(this != &v) {
+			std::swap(m_allocator_, v.m_allocator_);
+			std::swap(m_words_, v.m_words_);
+			std::swap(m_size_, v.m_size_);
+			std::swap(m_word_capacity_, v.m_word_capacity_);
+		}
+	}
+
+	//比较操作相关，逐字比较，末尾不足一字的部分按掩码比较
+	bool operator==(const Vector &v) const {
+		if(v.m_size_ != m_size_) {
+			return false;
+		}
+		size_type full = m_size_ / bit_word_size;
+		if(full != 0 && ::memcmp(m_words_, v.m_words_, full * sizeof(word_type)) != 0) {
+			return false;
+		}
+		size_type rest = m_size_ % bit_word_size;
+		return rest == 0 || ((m_words_[full] ^ v.m_words_[full]) & __bit_mask(0, rest)) == 0;
+	}
+
+	bool operator!=(const Vector &v) const {
+		return !operator==(v);
+	}
+
+	// 迭代器相关
+	inline iterator begin() {
+		return iterator(m_words_, 0);
+	}
+
+	inline iterator end() {
+		return begin() + static_cast<difference_type>(m_size_);
+	}
+
+	inline const_iterator begin() const {
+		return const_iterator(m_words_, 0);
+	}
+
+	inline const_iterator end() const {
+		return begin() + static_cast<difference_type>(m_size_);
+	}
+
+	inline const_iterator cbegin() const {
+		return begin();
+	}
+
+	inline const_iterator cend() const {
+		return end();
+	}
+
+	inline reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	inline reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	inline const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	inline const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// 容量相关
+	inline size_type size() const {
+		return m_size_;
+	}
+
+	inline size_type capacity() const {
+		return m_word_capacity_ * bit_word_size;
+	}
+
+	inline bool empty() const {
+		return m_size_ == 0;
+	}
+
+	inline void clear() {
+		release();
+		m_words_ = nullptr;
+		m_size_ = 0;
+		m_word_capacity_ = 0;
+	}
+
+	inline void resize(size_type n, bool x = false) {
+		if(n > m_size_) {
+			if(n > capacity()) {
+				reallocate_words(new_memory(n));
+			}
+			__bit_fill(end(), begin() + static_cast<difference_type>(n), x);
+		}
+		m_size_ = n;
+	}
+
+	void reserve(size_type n) {
+		if(capacity() < n) {
+			reallocate_words(word_number(n));
+		}
+	}
+
+	void shrink_to_fit() {
+		size_type used = word_number(m_size_);
+		if(used == m_word_capacity_) {
+			return;
+		}
+		if(used == 0) {
+			clear();
+			return;
+		}
+		word_pointer p = m_allocator_.allocate(used);
+		::memcpy(static_cast<void *>(p), static_cast<const void *>(m_words_), used * sizeof(word_type));
+		release();
+		m_words_ = p;
+		m_word_capacity_ = used;
+	}
+
+	// 元素相关
+	inline reference operator[](size_type n) {
+		return reference(m_words_ + n / bit_word_size, word_type(1) << (n % bit_word_size));
+	}
+
+	inline const_reference operator[](size_type n) const {
+		return (m_words_[n / bit_word_size] >> (n % bit_word_size)) & 1;
+	}
+
+	inline reference at(size_type n) {
+		return operator[](n);
+	}
+
+	inline const_reference at(size_type n) const {
+		return operator[](n);
+	}
+
+	inline reference front() {
+		return *begin();
+	}
+
+	inline const_reference front() const {
+		return *begin();
+	}
+
+	inline reference back() {
+		return *(end() - 1);
+	}
+
+	inline const_reference back() const {
+		return *(end() - 1);
+	}
+
+	// 底层的字数组，共word_number(size())个字
+	inline word_pointer data() {
+		return m_words_;
+	}
+
+	inline const_word_pointer data() const {
+		return m_words_;
+	}
+
+	// 按字的位运算，两者长度须相同
+	Vector &operator&=(const Vector &v) {
+		size_type n = word_number(m_size_);
+		for(size_type i = 0;i < n;++i) {
+			m_words_[i] &= v.m_words_[i];
+		}
+		return *this;
+	}
+
+	Vector &operator|=(const Vector &v) {
+		size_type n = word_number(m_size_);
+		for(size_type i = 0;i < n;++i) {
+			m_words_[i] |= v.m_words_[i];
+		}
+		return *this;
+	}
+
+	Vector &operator^=(const Vector &v) {
+		size_type n = word_number(m_size_);
+		for(size_type i = 0;i < n;++i) {
+			m_words_[i] ^= v.m_words_[i];
+		}
+		return *this;
+	}
+
+	// 翻转全部元素
+	void flip() {
+		size_type n = word_number(m_size_);
+		for(size_type i = 0;i < n;++i) {
+			m_words_[i] = ~m_words_[i];
+		}
+	}
+
+	// 增删操作
+	iterator insert(iterator pos, bool elem) {
+		return insert(pos, (size_type)1, elem);
+	}
+
+	iterator insert(iterator pos, size_type n, bool elem) {
+		auto p = make_gap(pos - begin(), n);
+		__bit_fill(p, p + static_cast<difference_type>(n), elem);
+		return p;
+	}
+
+	template <typename I>
+	iterator insert(iterator pos, I first, I last) {
+		return insert(pos, first, last, iterator_category(first));
+	}
+
+	inline void push_back(bool elem) {
+		if(m_size_ == capacity()) {
+			reallocate_words(new_memory(m_size_ + 1));
+		}
+		operator[](m_size_++) = elem;
+	}
+
+	inline void emplace_back(bool elem) {
+		push_back(elem);
+	}
+
+	iterator erase(iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase(iterator first, iterator last) {
+		bit_copy(const_iterator(last), cend(), first);
+		m_size_ -= last - first;
+		return first;
+	}
+
+	void pop_back() {
+		--m_size_;
+	}
+
+	// 分配器相关
+	inline ALLOCATOR get_allocator() {
+		return ALLOCATOR(m_allocator_);
+	}
+}; // class Vector<bool, ALLOCATOR, GROWTH>
+
+} // namespace stl
+
+#endif // _BIT_VECTOR_HPP__
@@ -0,0 +1,444 @@
+#ifndef _CIRCULAR_BUFFER_HPP__
+#define _CIRCULAR_BUFFER_HPP__
+
+/**
+ * 定容环形缓冲区
+ * 容量在构造时向上取整为2的幂，下标经掩码定位，两端的增删均为O(1)，构造后不再分配内存，
+ * 可作为Queue的底层容器；已满时的push与emplace触发断言，try_push_back等返回false
+*/
+
+#include <utility>
+#include <cassert>
+
+#include "allocator.hpp"
+#include "iterator.hpp"
+#include "reverse_iterator.hpp"
+#include "type_traits.hpp"
+
+namespace stl {
+
+template <typename T, bool Const>
+class CircularBufferIterator {
+public:
+	using iterator_category = random_access_iterator_tag;
+	using value_type = T;
+	using difference_type = ::ptrdiff_t;
+	using size_type = size_t;
+	using pointer = typename IfThenElse<Const, const T *, T *>::result;
+	using reference = typename IfThenElse<Const, const T &, T &>::result;
+
+	using self = CircularBufferIterator<T, Const>;
+private:
+	T *m_buffer_;
+	size_type m_mask_;
+	// 未经掩码的位置，相减即为距离
+	size_type m_pos_;
+public:
+	explicit CircularBufferIterator(T *buffer = nullptr, size_type mask = 0, size_type pos = 0) :
+		m_buffer_(buffer), m_mask_(mask), m_pos_(pos) {
+	}
+
+	// 可转换为常量迭代器
+	inline operator CircularBufferIterator<T, true>() const {
+		return CircularBufferIterator<T, true>(m_buffer_, m_mask_, m_pos_);
+	}
+
+	inline reference operator*() const {
+		return m_buffer_[m_pos_ & m_mask_];
+	}
+
+	inline pointer operator->() const {
+		return &operator*();
+	}
+
+	inline reference operator[](difference_type n) const {
+		return m_buffer_[(m_pos_ + n) & m_mask_];
+	}
+
+	inline difference_type operator-(const self &s) const {
+		return static_cast<difference_type>(m_pos_ - s.m_pos_);
+	}
+
+	inline bool operator==(const self &s) const {
+		return m_pos_ == s.m_pos_;
+	}
+
+	inline bool operator!=(const self &s) const {
+		return m_pos_ != s.m_pos_;
+	}
+
+	inline bool operator<(const self &s) const {
+		return *this - s < 0;
+	}
+
+	inline bool operator>(const self &s) const {
+		return *this - s > 0;
+	}
+
+	inline bool operator<=(const self &s) const {
+		return *this - s <= 0;
+	}
+
+	inline bool operator>=(const self &s) const {
+		return *this - s >= 0;
+	}
+
+	inline self &operator+=(difference_type n) {
+		m_pos_ += n;
+		return *this;
+	}
+
+	inline self &operator-=(difference_type n) {
+		m_pos_ -= n;
+		return *this;
+	}
+
+	inline self operator+(difference_type n) const {
+		return self(m_buffer_, m_mask_, m_pos_ + n);
+	}
+
+	inline self operator-(difference_type n) const {
+		return self(m_buffer_, m_mask_, m_pos_ - n);
+	}
+
+	inline self &operator++() {
+		++m_pos_;
+		return *this;
+	}
+
+	inline self operator++(int) {
+		self s = *this;
+		++m_pos_;
+		return s;
+	}
+
+	inline self &operator--() {
+		--m_pos_;
+		return *this;
+	}
+
+	inline self operator--(int) {
+		self s = *this;
+		--m_pos_;
+		return s;
+	}
+}; // class CircularBufferIterator
+
+template <typename T, typename ALLOC = Allocator<T>>
+class CircularBuffer {
+public:
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	using iterator = CircularBufferIterator<T, false>;
+	using const_iterator = CircularBufferIterator<T, true>;
+	using reverse_iterator = ReverseIterator<iterator>;
+	using const_reverse_iterator = ReverseIterator<const_iterator>;
+private:
+	ALLOC m_allocator_;
+
+	pointer m_buffer_;
+	// 容量减一，容量为0时亦为0
+	size_type m_mask_;
+	// 首元素的下标，始终小于容量
+	size_type m_head_;
+	size_type m_size_;
+
+	inline pointer address(size_type n) const {
+		return m_buffer_ + ((m_head_ + n) & m_mask_);
+	}
+
+	// 不小于n的最小的2的幂
+	static inline size_type ceil_pow2(size_type n) {
+		size_type p = 1;
+		while(p < n) {
+			p <<= 1;
+		}
+		return p;
+	}
+
+	void release() {
+		clear();
+		if(m_buffer_ != nullptr) {
+			m_allocator_.deallocate(m_buffer_, capacity());
+		}
+	}
+public:
+	CircularBuffer() :
+		m_buffer_(nullptr),
+		m_mask_(0),
+		m_head_(0),
+		m_size_(0) {
+	}
+
+	explicit CircularBuffer(const ALLOC &allocator) :
+		m_allocator_(allocator),
+		m_buffer_(nullptr),
+		m_mask_(0),
+		m_head_(0),
+		m_size_(0) {
+	}
+
+	// 容量向上取整为2的幂，此后不再分配内存
+	explicit CircularBuffer(size_type capacity, const ALLOC &allocator = ALLOC()) :CircularBuffer(allocator) {
+		if(capacity != 0) {
+			size_type cap = ceil_pow2(capacity);
+			m_buffer_ = m_allocator_.allocate(cap);
+			m_mask_ = cap - 1;
+		}
+	}
+
+	template <typename InputIterator>
+	explicit CircularBuffer(size_type capacity, InputIterator first, InputIterator last) :CircularBuffer(capacity) {
+		for(;first != last;++first) {
+			emplace_back(*first);
+		}
+	}
+
+	CircularBuffer(const CircularBuffer &c) :CircularBuffer(c.capacity(), c.m_allocator_) {
+		for(size_type i = 0;i < c.m_size_;++i) {
+			emplace_back(c[i]);
+		}
+	}
+
+	CircularBuffer(CircularBuffer &&c) noexcept :
+		m_allocator_(c.m_allocator_),
+		m_buffer_(c.m_buffer_),
+		m_mask_(c.m_mask_),
+		m_head_(c.m_head_),
+		m_size_(c.m_size_) {
+		c.m_buffer_ = nullptr;
+		c.m_mask_ = 0;
+		c.m_head_ = 0;
+		c.m_size_ = 0;
+	}
+
+	~CircularBuffer() {
+		release();
+	}
+
+	CircularBuffer &operator=(const CircularBuffer &c) {
+		if(this != &c) {
+			CircularBuffer tmp(c);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	CircularBuffer &operator=(CircularBuffer &&c) {
+		if(this != &c) {
+			CircularBuffer tmp(std::move(c));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	void swap(CircularBuffer &c) {
+		std::swap(m_allocator_, c.m_allocator_);
+		std::swap(m_buffer_, c.m_buffer_);
+		std::swap(m_mask_, c.m_mask_);
+		std::swap(m_head_, c.m_head_);
+		std::swap(m_size_, c.m_size_);
+	}
+
+	bool operator==(const CircularBuffer &c) const {
+		if(c.m_size_ != m_size_) {
+			return false;
+		}
+		for(size_type i = 0;i < m_size_;++i) {
+			if(!(c[i] == operator[](i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const CircularBuffer &c) const {
+		return !operator==(c);
+	}
+
+	// 迭代器相关
+	inline iterator begin() {
+		return iterator(m_buffer_, m_mask_, m_head_);
+	}
+
+	inline iterator end() {
+		return iterator(m_buffer_, m_mask_, m_head_ + m_size_);
+	}
+
+	inline const_iterator begin() const {
+		return const_iterator(m_buffer_, m_mask_, m_head_);
+	}
+
+	inline const_iterator end() const {
+		return const_iterator(m_buffer_, m_mask_, m_head_ + m_size_);
+	}
+
+	inline reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	inline reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	inline const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	inline const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// 容量相关
+	inline size_type size() const {
+		return m_size_;
+	}
+
+	inline size_type capacity() const {
+		return m_buffer_ == nullptr ? 0 : m_mask_ + 1;
+	}
+
+	inline bool empty() const {
+		return m_size_ == 0;
+	}
+
+	inline bool full() const {
+		return m_size_ == capacity();
+	}
+
+	void clear() {
+		for(size_type i = 0;i < m_size_;++i) {
+			m_allocator_.destory(address(i));
+		}
+		m_head_ = 0;
+		m_size_ = 0;
+	}
+
+	// 元素相关
+	inline reference operator[](size_type n) {
+		return *address(n);
+	}
+
+	inline const_reference operator[](size_type n) const {
+		return *address(n);
+	}
+
+	inline reference at(size_type n) {
+		return *address(n);
+	}
+
+	inline const_reference at(size_type n) const {
+		return *address(n);
+	}
+
+	inline reference front() {
+		return m_buffer_[m_head_];
+	}
+
+	inline const_reference front() const {
+		return m_buffer_[m_head_];
+	}
+
+	inline reference back() {
+		return *address(m_size_ - 1);
+	}
+
+	inline const_reference back() const {
+		return *address(m_size_ - 1);
+	}
+
+	// 增删操作
+	inline void push_back(const value_type &elem) {
+		emplace_back(elem);
+	}
+
+	inline void push_back(value_type &&elem) {
+		emplace_back(std::move(elem));
+	}
+
+	inline void push_front(const value_type &elem) {
+		emplace_front(elem);
+	}
+
+	inline void push_front(value_type &&elem) {
+		emplace_front(std::move(elem));
+	}
+
+	template <typename ... Args>
+	inline void emplace_back(Args&& ... args) {
+		assert(!full());
+		m_allocator_.construct(address(m_size_), std::forward<Args>(args)...);
+		++m_size_;
+	}
+
+	template <typename ... Args>
+	inline void emplace_front(Args&& ... args) {
+		assert(!full());
+		size_type head = (m_head_ - 1) & m_mask_;
+		m_allocator_.construct(m_buffer_ + head, std::forward<Args>(args)...);
+		m_head_ = head;
+		++m_size_;
+	}
+
+	inline bool try_push_back(const value_type &elem) {
+		return try_emplace_back(elem);
+	}
+
+	inline bool try_push_back(value_type &&elem) {
+		return try_emplace_back(std::move(elem));
+	}
+
+	template <typename ... Args>
+	inline bool try_emplace_back(Args&& ... args) {
+		if(full()) {
+			return false;
+		}
+		emplace_back(std::forward<Args>(args)...);
+		return true;
+	}
+
+	template <typename ... Args>
+	inline bool try_emplace_front(Args&& ... args) {
+		if(full()) {
+			return false;
+		}
+		emplace_front(std::forward<Args>(args)...);
+		return true;
+	}
+
+	inline void pop_back() {
+		--m_size_;
+		m_allocator_.destory(address(m_size_));
+	}
+
+	inline void pop_front() {
+		m_allocator_.destory(m_buffer_ + m_head_);
+		m_head_ = (m_head_ + 1) & m_mask_;
+		--m_size_;
+	}
+
+	// 分配器相关
+	inline ALLOC get_allocator() {
+		return m_allocator_;
+	}
+}; // class CircularBuffer
+
+// 迭代器仅持有缓冲区指针，可按位搬移
+template <typename T, typename ALLOC>
+struct is_trivially_relocatable<CircularBuffer<T, ALLOC>> :members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<CircularBuffer<T, ALLOC>>
+
+template <typename T, typename ALLOC>
+void swap(CircularBuffer<T, ALLOC> &c, CircularBuffer<T, ALLOC> &cc) {
+	c.swap(cc);
+}
+
+} // namespace stl
+
+#endif // _CIRCULAR_BUFFER_HPP__
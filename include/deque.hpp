@@ -6,13 +6,27 @@
 #include "allocator.hpp"
 #include "algobase.hpp"
 #include "reverse_iterator.hpp"
+#include "type_traits.hpp"
 
 #include <string.h>
 
 namespace stl {
 
-inline size_t tinystl_deque_buf_size(size_t n, size_t st) {
-	return (n != 0) ? n : (512 < st ? (1) : (512 / st));
+#ifndef _TINY_STL_DEQUE_BLOCK_BYTES_
+// 缓冲区的目标字节数，可在包含头文件前定义以调整
+#define _TINY_STL_DEQUE_BLOCK_BYTES_ 512
+#endif // _TINY_STL_DEQUE_BLOCK_BYTES_
+
+// 缓冲区的元素数，n为0时取不超过bytes / st的最大的2的幂，元素过大时为1
+inline constexpr size_t tinystl_deque_buf_size(size_t n, size_t st, size_t bytes = _TINY_STL_DEQUE_BLOCK_BYTES_) {
+	return n != 0 ? n : tinystl_floor_pow2(bytes / st);
+}
+
+// 缓冲区的目标字节数，不小于配置器的对齐值，使用按页对齐的配置器时缓冲区恰为整页
+template <typename ALLOC>
+inline constexpr size_t tinystl_deque_block_bytes() {
+	return allocator_traits<ALLOC>::alignment > _TINY_STL_DEQUE_BLOCK_BYTES_ ?
+		allocator_traits<ALLOC>::alignment : _TINY_STL_DEQUE_BLOCK_BYTES_;
 }
 
 template <typename T, size_t BufferSize>
@@ -21,6 +35,9 @@ public:
 	template <typename U, size_t BS, typename ALLOC>
 	friend class Deque;
 
+	template <typename I>
+	friend struct segmented_iterator_traits;
+
 	using iterator_category = random_access_iterator_tag;
 	using value_type = T;
 	using difference_type = ::ptrdiff_t;
@@ -59,7 +76,7 @@ private:
 	}
 public:
 	explicit DequeIterator(pointer cur = nullptr, map_pointer map_ptr = nullptr) :
-		m_cur_(cur), m_map_(map_ptr) {
+		m_first_(nullptr), m_last_(nullptr), m_cur_(cur), m_map_(map_ptr) {
 		if(m_map_ != nullptr) {
 			m_first_ = *m_map_;
 			m_last_ = m_first_ + buffer_size();
@@ -148,6 +165,36 @@ public:
 	}
 }; // class DequeIterator
 
+// 每个缓冲区为一段连续内存
+template <typename T, size_t BufferSize>
+struct segmented_iterator_traits<DequeIterator<T, BufferSize>> {
+	using is_segmented = true_type;
+	using iterator = DequeIterator<T, BufferSize>;
+	using segment_iterator = typename iterator::map_pointer;
+	using local_iterator = typename iterator::pointer;
+
+	static inline segment_iterator segment(const iterator &i) {
+		return i.m_map_;
+	}
+
+	static inline local_iterator local(const iterator &i) {
+		return i.m_cur_;
+	}
+
+	static inline local_iterator begin(segment_iterator s) {
+		return *s;
+	}
+
+	static inline local_iterator end(segment_iterator s) {
+		return *s + iterator::buffer_size();
+	}
+
+	// 位于段末尾时归入下一段的起始处，与迭代器自增的结果一致
+	static inline iterator compose(segment_iterator s, local_iterator l) {
+		return l == end(s) ? iterator(*(s + 1), s + 1) : iterator(l, s);
+	}
+}; // struct segmented_iterator_traits<DequeIterator<T, BufferSize>>
+
 template <typename T, size_t BufferSize = 0, typename ALLOC = Allocator<T>>
 class Deque {
 public:
@@ -159,7 +206,7 @@ public:
 	using size_type = std::size_t;
 	using difference_type = std::ptrdiff_t;
 
-	using iterator = DequeIterator<T, BufferSize>;
+	using iterator = DequeIterator<T, tinystl_deque_buf_size(BufferSize, sizeof(T), tinystl_deque_block_bytes<ALLOC>())>;
 	using const_iterator = const iterator;
 	using reverse_iterator = ReverseIterator<iterator>;
 	using const_reverse_iterator = const ReverseIterator<iterator>;
@@ -170,12 +217,16 @@ public:
 	using self = Deque<T, BufferSize, ALLOC>;
 
 	static inline constexpr size_type buffer_size() {
-		return DequeIterator<T, BufferSize>::buffer_size();
+		return iterator::buffer_size();
 	}
 private:
 	ALLOC m_buffer_allocator_;
 	typename ALLOC::template rebind<map_type>::other m_map_allocator_;
 
+	// 映射表的存储空间，已分配缓冲区的结点[m_map_first_, m_map_last_)位于其中，两侧为空位
+	map_pointer m_map_storage_;
+	size_type m_map_capacity_;
+
 	map_pointer m_map_first_;
 	map_pointer m_map_last_;
 
@@ -188,7 +239,9 @@ private:
 	}
 
 	void create_uninit_mem(size_type n) {
-		m_map_first_ = m_map_allocator_.allocate(map_node_number(n));
+		m_map_storage_ = m_map_allocator_.allocate(map_node_number(n));
+		m_map_capacity_ = map_node_number(n);
+		m_map_first_ = m_map_storage_;
 		m_map_last_ = m_map_first_ + map_node_number(n);
 
 		for(map_pointer p = m_map_first_;p != m_map_last_;++p) {
@@ -212,10 +265,38 @@ private:
 			(m_first_.m_cur_ - m_first_.m_first_);
 	}
 
-	// 后方剩余空间
+	// 后方剩余空间，尾迭代器不能位于缓冲区末尾，故需扣除一个位置
 	size_t free_back() const {
 		return buffer_size() * (m_map_last_ - 1 - m_last_.m_map_) +
-			(m_last_.m_last_ - m_last_.m_cur_);
+			(m_last_.m_last_ - m_last_.m_cur_) - 1;
+	}
+
+	static void reverse_map(map_pointer first, map_pointer last) {
+		for(;first < last;++first) {
+			--last;
+			map_type tmp = *first;
+			*first = *last;
+			*last = tmp;
+		}
+	}
+
+	// 将映射表另一端已腾空的缓冲区轮转至所需的一端，至多n个，返回复用的缓冲区数
+	// 先进先出时头部腾空的缓冲区由尾部复用，映射表与缓冲区均无需重新分配
+	size_type recycle_blocks(size_type n, bool dis) {
+		size_type spare = dis ? m_map_last_ - 1 - m_last_.m_map_ : m_first_.m_map_ - m_map_first_;
+		size_type k = stl::min(n, spare);
+		if(k == 0) {
+			return 0;
+		}
+		// 向前时右移k个位置，向后时左移k个位置
+		map_pointer middle = dis ? m_map_last_ - k : m_map_first_ + k;
+		reverse_map(m_map_first_, middle);
+		reverse_map(middle, m_map_last_);
+		reverse_map(m_map_first_, m_map_last_);
+		difference_type off = dis ? difference_type(k) : -difference_type(k);
+		m_first_.m_map_ += off;
+		m_last_.m_map_ += off;
+		return k;
 	}
 
 	// 准备向某方向的内存，dis为true表示向前，否则表示向后
@@ -238,33 +319,206 @@ private:
 		if(free_mem >= add_size) {
 			return;
 		}
-		size_type nn = m_map_last_ - m_map_first_;
 		size_type n = map_node_number(add_size - free_mem - 1);
+		n -= recycle_blocks(n, dis);
+		if(n == 0) {
+			return;
+		}
 
-		map_pointer p = m_map_allocator_.allocate(n + nn);
+		// 一次留足映射表的空位，再一次分配全部所需的缓冲区
+		reserve_map(n, dis);
+		for(size_type i = 0;i < n;++i) {
+			if(dis) {
+				*--m_map_first_ = m_buffer_allocator_.allocate(buffer_size());
+			} else {
+				*m_map_last_++ = m_buffer_allocator_.allocate(buffer_size());
+			}
+		}
+	}
 
-		map_pointer copy_p = p, ctor_p = p;
-		if(dis) {
-			copy_p += n;
+	// 保证映射表在某方向留有n个空位，dis含义同上
+	// 存储空间足够时将已有结点居中，否则按倍数扩展，逐个追加缓冲区时映射表的复制总量为线性
+	void reserve_map(size_type n, bool dis) {
+		size_type slack = dis ? m_map_first_ - m_map_storage_ : m_map_storage_ + m_map_capacity_ - m_map_last_;
+		if(slack >= n) {
+			return;
+		}
+		size_type nn = m_map_last_ - m_map_first_;
+		map_pointer p = m_map_storage_;
+		size_type ncap = m_map_capacity_;
+		if(nn + n > m_map_capacity_ / 2) {
+			ncap = stl::max(m_map_capacity_ * 2, nn + n);
+			p = m_map_allocator_.allocate(ncap);
+		}
+		map_pointer first = p + (ncap - nn - n) / 2 + (dis ? n : 0);
+		::memmove(first, m_map_first_, nn * sizeof(map_type));
+
+		m_first_.m_map_ = first + (m_first_.m_map_ - m_map_first_);
+		m_last_.m_map_ = first + (m_last_.m_map_ - m_map_first_);
+
+		if(p != m_map_storage_) {
+			m_map_allocator_.deallocate(m_map_storage_, m_map_capacity_);
+			m_map_storage_ = p;
+			m_map_capacity_ = ncap;
+		}
+		m_map_first_ = first;
+		m_map_last_ = first + nn;
+	}
+
+	// 在pos起的n个未构造位置逐个缓冲区整段构造first起的元素，返回源区间的结束位置
+	// 构造过程中抛出异常时析构已构造的元素
+	template <typename ForwardIterator>
+	ForwardIterator construct_blocks(iterator pos, size_type n, ForwardIterator first) {
+		iterator start = pos;
+		try {
+			while(n > 0) {
+				size_type chunk = stl::min<size_type>(n, pos.m_last_ - pos.m_cur_);
+				ForwardIterator last = first;
+				stl::advance(last, chunk);
+				uninitialized_copy(first, last, pos.m_cur_, m_buffer_allocator_);
+				first = last;
+				pos += chunk;
+				n -= chunk;
+			}
+		} catch(...) {
+			for(;start != pos;++start) {
+				m_buffer_allocator_.destory(start.m_cur_);
+			}
+			throw;
+		}
+		return first;
+	}
+
+	// 析构全部元素，保留映射表与缓冲区
+	void destory_elements() {
+		if(m_first_.m_map_ == m_last_.m_map_) {
+			initialized_destory(m_first_.m_cur_, m_last_.m_cur_, m_buffer_allocator_);
 		} else {
-			ctor_p += nn;
+			map_pointer p = m_first_.m_map_ + 1;
+			initialized_destory(m_first_.m_cur_, m_first_.m_last_, m_buffer_allocator_);
+			initialized_destory(m_last_.m_first_, m_last_.m_cur_, m_buffer_allocator_);
+			for(;p != m_last_.m_map_;++p) {
+				initialized_destory(*p, *p + buffer_size(), m_buffer_allocator_);
+			}
 		}
+	}
 
-		for(size_type i = 0;i < n;++i) {
-			ctor_p[i] = m_buffer_allocator_.allocate(buffer_size());
+	// 析构全部元素，首尾迭代器移至首个缓冲区的起始处，缓冲区留待复用
+	void reset() {
+		if(m_map_first_ == nullptr) {
+			return;
+		}
+		destory_elements();
+		m_first_ = iterator(*m_map_first_, m_map_first_);
+		m_last_ = m_first_;
+	}
+
+	// 整数实参视为元素数与初值，如Deque<int>的assign(3, 5)
+	template <typename Integer>
+	void assign_dispatch(Integer n, Integer x, true_type) {
+		assign(static_cast<size_type>(n), static_cast<value_type>(x));
+	}
+
+	template <typename InputIterator>
+	void assign_dispatch(InputIterator first, InputIterator last, false_type) {
+		assign(first, last, iterator_category(first));
+	}
+
+	template <typename InputIterator>
+	void assign(InputIterator first, InputIterator last, input_iterator_tag) {
+		reset();
+		for(;first != last;++first) {
+			emplace_back(*first);
 		}
-		::memcpy(copy_p, m_map_first_, nn * sizeof(map_type));
+	}
 
-		m_first_.m_map_ = copy_p + (m_first_.m_map_ - m_map_first_);
-		m_last_.m_map_ = copy_p + (m_last_.m_map_ - m_map_first_);
+	// 先算出元素数，映射表与缓冲区一次备齐后逐缓冲区整段构造
+	template <typename ForwardIterator>
+	void assign(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		size_type n = stl::distance(first, last);
+		reset();
+		if(n == 0) {
+			return;
+		}
+		reserve_back(n);
+		construct_blocks(m_last_, n, first);
+		m_last_ += n;
+	}
+
+	// 元素类型是否可按位搬移
+	static constexpr bool trivially_relocatable = tag_value<typename is_trivially_relocatable<T>::type>::value;
+
+	// 按缓冲区分段将[first, last)由前向后整段搬移至result，适用于result位于first之前
+	void relocate_forward(iterator first, iterator last, iterator result) {
+		difference_type n = last - first;
+		while(n > 0) {
+			difference_type chunk = stl::min(n, stl::min<difference_type>(first.m_last_ - first.m_cur_,
+				result.m_last_ - result.m_cur_));
+			::memmove(static_cast<void *>(result.m_cur_), static_cast<const void *>(first.m_cur_),
+				chunk * sizeof(value_type));
+			first += chunk;
+			result += chunk;
+			n -= chunk;
+		}
+	}
 
-		m_map_allocator_.deallocate(m_map_first_, nn);
+	// 按缓冲区分段将[first, last)由后向前整段搬移至result结尾处，适用于result位于last之后
+	void relocate_backward(iterator first, iterator last, iterator result) {
+		difference_type n = last - first;
+		while(n > 0) {
+			// 位于缓冲区起始处时，待搬移的元素在上一个缓冲区中
+			pointer src = last.m_cur_ == last.m_first_ ? *(last.m_map_ - 1) + buffer_size() : last.m_cur_;
+			pointer dst = result.m_cur_ == result.m_first_ ? *(result.m_map_ - 1) + buffer_size() : result.m_cur_;
+			difference_type src_run = last.m_cur_ == last.m_first_ ?
+				difference_type(buffer_size()) : last.m_cur_ - last.m_first_;
+			difference_type dst_run = result.m_cur_ == result.m_first_ ?
+				difference_type(buffer_size()) : result.m_cur_ - result.m_first_;
+			difference_type chunk = stl::min(n, stl::min(src_run, dst_run));
+			::memmove(static_cast<void *>(dst - chunk), static_cast<const void *>(src - chunk),
+				chunk * sizeof(value_type));
+			last -= chunk;
+			result -= chunk;
+			n -= chunk;
+		}
+	}
 
-		m_map_first_ = p;
-		m_map_last_ = m_map_first_ + n + nn;
+	// 可按位搬移的类型整段搬移插入位置一侧的元素，空出[pos, pos + n)，返回新的pos
+	// 首尾迭代器保持不变，新元素全部构造后再由commit_gap计入容器
+	iterator open_gap(iterator pos, size_type n, bool dis) {
+		if(dis) {
+			relocate_forward(m_first_, pos, m_first_ - n);
+			return pos - n;
+		}
+		relocate_backward(pos, m_last_, m_last_ + n);
+		return pos;
+	}
+
+	// 在空位[pos, pos + n)中构造新元素失败时，将已搬移的元素移回原处
+	void close_gap(iterator pos, size_type n, bool dis) {
+		if(dis) {
+			relocate_backward(m_first_ - n, pos, pos + n);
+		} else {
+			relocate_forward(pos + n, m_last_ + n, pos);
+		}
+	}
+
+	inline void commit_gap(size_type n, bool dis) {
+		if(dis) {
+			m_first_ -= n;
+		} else {
+			m_last_ += n;
+		}
 	}
 public:
-	Deque() :m_map_first_(nullptr), m_map_last_(nullptr), m_first_(), m_last_() {
+	Deque() :
+		m_map_storage_(nullptr), m_map_capacity_(0),
+		m_map_first_(nullptr), m_map_last_(nullptr), m_first_(), m_last_() {
+	}
+
+	explicit Deque(const ALLOC &allocator) :
+		m_buffer_allocator_(allocator), m_map_allocator_(allocator),
+		m_map_storage_(nullptr), m_map_capacity_(0),
+		m_map_first_(nullptr), m_map_last_(nullptr), m_first_(), m_last_() {
 	}
 
 	Deque(size_type n) :Deque() {
@@ -274,8 +528,8 @@ public:
 		create_uninit_mem(n);
 
 		auto tmp = n;
-		for(map_pointer p = m_map_first_;p != m_map_last_;++p, tmp -= n) {
-			uninitialized_fill(*p, (*p) + std::min(buffer_size(), tmp), m_buffer_allocator_);
+		for(map_pointer p = m_map_first_;p != m_map_last_;++p, tmp -= buffer_size()) {
+			uninitialized_fill(*p, (*p) + stl::min(buffer_size(), tmp), m_buffer_allocator_);
 		}
 	}
 
@@ -286,33 +540,27 @@ public:
 		create_uninit_mem(n);
 
 		auto tmp = n;
-		for(map_pointer p = m_map_first_;p != m_map_last_;++p, tmp -= n) {
-			uninitialized_fill(x, *p, (*p) + std::min(buffer_size(), tmp), m_buffer_allocator_);
+		for(map_pointer p = m_map_first_;p != m_map_last_;++p, tmp -= buffer_size()) {
+			uninitialized_fill(x, *p, (*p) + stl::min(buffer_size(), tmp), m_buffer_allocator_);
 		}
 	}
 
 	template <typename InputIterator>
 	Deque(InputIterator first, InputIterator last) :Deque() {
-		auto n = distance(first, last);
-
-		if(n == 0) {
-			return;
-		}
-
-		create_uninit_mem(n);
-
-		auto p = m_first_;
-		for(auto q = first;q != last;++q, ++p) {
-			m_buffer_allocator_.construct(p.m_cur_, *q);
-		}
+		assign(first, last);
 	}
 
-	Deque(const self &other) :Deque(other.begin(), other.end()) {
+	Deque(const self &other) :Deque(other.m_buffer_allocator_) {
+		assign(other.m_first_, other.m_last_);
 	}
 
-	Deque(self &&other) :
+	Deque(self &&other) noexcept :
+		m_buffer_allocator_(other.m_buffer_allocator_), m_map_allocator_(other.m_map_allocator_),
+		m_map_storage_(other.m_map_storage_), m_map_capacity_(other.m_map_capacity_),
 		m_map_first_(other.m_map_first_), m_map_last_(other.m_map_last_),
 		m_first_(other.m_first_), m_last_(other.m_last_) {
+		other.m_map_storage_ = nullptr;
+		other.m_map_capacity_ = 0;
 		other.m_map_first_ = nullptr;
 		other.m_map_last_ = nullptr;
 		other.m_first_.clear();
@@ -325,17 +573,7 @@ public:
 
 	self &operator=(const self &other) {
 		if(this != &other) {
-			clear();
-
-			size_type n = other.size();
-			if(n > 0) {
-				create_uninit_mem(n);
-
-				auto p = m_first_;
-				for(auto q = other.m_first_;q != other.m_last_;++q, ++p) {
-					m_buffer_allocator_.construct(p.m_cur_, *q);
-				}
-			}
+			assign(other.m_first_, other.m_last_);
 		}
 		return *this;
 	}
@@ -344,11 +582,17 @@ public:
 		if(this != &other) {
 			clear();
 
+			m_buffer_allocator_ = other.m_buffer_allocator_;
+			m_map_allocator_ = other.m_map_allocator_;
+			m_map_storage_ = other.m_map_storage_;
+			m_map_capacity_ = other.m_map_capacity_;
 			m_map_first_ = other.m_map_first_;
 			m_map_last_ = other.m_map_last_;
 			m_first_ = other.m_first_;
 			m_last_ = other.m_last_;
 
+			other.m_map_storage_ = nullptr;
+			other.m_map_capacity_ = 0;
 			other.m_map_first_ = nullptr;
 			other.m_map_last_ = nullptr;
 			other.m_first_.clear();
@@ -357,6 +601,24 @@ public:
 		return *this;
 	}
 
+	template <typename InputIterator>
+	void assign(InputIterator first, InputIterator last) {
+		assign_dispatch(first, last, bool_type<std::is_integral<InputIterator>::value>());
+	}
+
+	void assign(size_type n, const value_type &x) {
+		// x可能引用容器内的元素，析构前先行复制
+		value_type value(x);
+		reset();
+		reserve_back(n);
+		for(size_type rest = n;rest > 0;) {
+			size_type chunk = stl::min<size_type>(rest, m_last_.m_last_ - m_last_.m_cur_);
+			uninitialized_fill(value, m_last_.m_cur_, m_last_.m_cur_ + chunk, m_buffer_allocator_);
+			m_last_ += chunk;
+			rest -= chunk;
+		}
+	}
+
 	void swap(self &d) {
 		if(this != &d) {
 			stl::swap(*this, d);
@@ -440,7 +702,11 @@ public:
 	}
 
 	void shrink_to_fit() {
-		if(m_first_.m_map_ == m_map_first_ && m_last_.m_map_ + 1 == m_map_last_) {
+		if(m_map_first_ == nullptr) {
+			return;
+		}
+		if(m_first_.m_map_ == m_map_first_ && m_last_.m_map_ + 1 == m_map_last_ &&
+			m_map_last_ - m_map_first_ == difference_type(m_map_capacity_)) {
 			return;
 		}
 
@@ -449,7 +715,7 @@ public:
 			if(*p == nullptr) {
 				continue;
 			}
-			m_map_allocator_.deallocate(*p, buffer_size());
+			m_buffer_allocator_.deallocate(*p, buffer_size());
 			*p = nullptr;
 		}
 
@@ -457,7 +723,7 @@ public:
 			if(*p == nullptr) {
 				continue;
 			}
-			m_map_allocator_.deallocate(*p, buffer_size());
+			m_buffer_allocator_.deallocate(*p, buffer_size());
 			*p = nullptr;
 		}
 
@@ -465,29 +731,49 @@ public:
 		difference_type n = m_last_.m_map_ - m_first_.m_map_ + 1;
 		map_pointer p = m_map_allocator_.allocate(n);
 		::memcpy(p, m_first_.m_map_, n * sizeof(map_type));
-		m_map_allocator_.deallocate(m_map_first_, m_map_last_ - m_map_first_);
+		m_map_allocator_.deallocate(m_map_storage_, m_map_capacity_);
 
 		// 分配新迭代器
+		m_map_storage_ = p;
+		m_map_capacity_ = n;
 		m_map_first_ = p;
 		m_map_last_ = p + n;
 		m_first_.m_map_ = m_map_first_;
 		m_last_.m_map_ = m_map_last_ - 1;
 	}
 
+	// 预留前方或后方至少n个元素的空间，映射表与所需的缓冲区一次分配到位
+	void reserve_front(size_type n) {
+		if(n != 0) {
+			ready_memory(n, true);
+		}
+	}
+
+	void reserve_back(size_type n) {
+		if(n != 0) {
+			ready_memory(n, false);
+		}
+	}
+
+	// 调整元素数为n，新增元素默认初始化，可平凡默认构造的类型不写入内存，内容未定
+	void resize_default_init(size_type n) {
+		size_type si = size();
+		if(n < si) {
+			erase(m_first_ + n, m_last_);
+			return;
+		}
+		reserve_back(n - si);
+		for(size_type rest = n - si;rest > 0;) {
+			size_type chunk = stl::min<size_type>(rest, m_last_.m_last_ - m_last_.m_cur_);
+			uninitialized_default_fill(m_last_.m_cur_, m_last_.m_cur_ + chunk, m_buffer_allocator_);
+			m_last_ += chunk;
+			rest -= chunk;
+		}
+	}
+
 	void clear() {
 		if(m_map_first_ != nullptr) {
-
-			// 进行析构
-			if(m_first_.m_map_ == m_last_.m_map_) {
-				initialized_destory(m_first_.m_cur_, m_last_.m_cur_, m_buffer_allocator_);
-			} else {
-				map_pointer p = m_first_.m_map_ + 1;
-				initialized_destory(m_first_.m_cur_, m_first_.m_last_, m_buffer_allocator_);
-				initialized_destory(m_last_.m_first_, m_last_.m_cur_, m_buffer_allocator_);
-				for(;p != m_last_.m_map_;++p) {
-					initialized_destory(*p, *p + buffer_size(), m_buffer_allocator_);
-				}
-			}
+			destory_elements();
 			m_first_.clear();
 			m_last_.clear();
 
@@ -498,7 +784,9 @@ public:
 				m_buffer_allocator_.deallocate(*p, buffer_size());
 				*p != nullptr;
 			}
-			m_map_allocator_.deallocate(m_map_first_, m_map_last_ - m_map_first_);
+			m_map_allocator_.deallocate(m_map_storage_, m_map_capacity_);
+			m_map_storage_ = nullptr;
+			m_map_capacity_ = 0;
 			m_map_first_ = nullptr;
 			m_map_last_ = nullptr;
 		}
@@ -519,11 +807,22 @@ public:
 		bool dis = pos_front < pos_back;
 		ready_memory(1, dis);
 		pos = m_first_ + pos_front;
+		if(trivially_relocatable) {
+			pos = open_gap(pos, 1, dis);
+			try {
+				m_buffer_allocator_.construct(pos.m_cur_, std::move(elem));
+			} catch(...) {
+				close_gap(pos, 1, dis);
+				throw;
+			}
+			commit_gap(1, dis);
+			return pos;
+		}
 		if(dis) {
 			if(pos != m_first_) {
 				m_buffer_allocator_.construct((m_first_ - 1).m_cur_, std::move(*m_first_));
 
-				for(auto i = m_first_;i != pos;++i) {
+				for(auto i = m_first_;i != pos - 1;++i) {
 					*(i) = std::move(*(i + 1));
 				}
 
@@ -560,6 +859,25 @@ public:
 		bool dis = pos_front < pos_back;
 		ready_memory(n, dis);
 		pos = m_first_ + pos_front;
+		if(trivially_relocatable) {
+			// elem可能引用容器内的元素，搬移前先行复制
+			value_type value(elem);
+			pos = open_gap(pos, n, dis);
+			auto p = pos;
+			try {
+				for(auto e = pos + n;p != e;++p) {
+					m_buffer_allocator_.construct(p.m_cur_, value);
+				}
+			} catch(...) {
+				for(;p != pos;--p) {
+					m_buffer_allocator_.destory((p - 1).m_cur_);
+				}
+				close_gap(pos, n, dis);
+				throw;
+			}
+			commit_gap(n, dis);
+			return pos;
+		}
 		if(dis) {
 			auto move_number = pos_front;
 
@@ -644,17 +962,41 @@ public:
 
 	template <typename InputIterator>
 	iterator insert(iterator pos, InputIterator first, InputIterator last) {
-		difference_type n = distance(first, last);
+		difference_type n = stl::distance(first, last);
 
 		if(pos.m_map_ == nullptr) {
 			*this = std::move(self(first, last));
 			return begin();
 		}
+		// 在两端插入时无需移动元素，一次备齐空间后逐缓冲区整段构造
+		if(pos == m_last_) {
+			ready_memory(n, false);
+			construct_blocks(m_last_, n, first);
+			m_last_ += n;
+			return m_last_ - n;
+		}
+		if(pos == m_first_) {
+			ready_memory(n, true);
+			construct_blocks(m_first_ - n, n, first);
+			m_first_ -= n;
+			return m_first_;
+		}
 		difference_type pos_front = pos - begin();
 		difference_type pos_back = end() - pos;
 		bool dis = pos_front < pos_back;
 		ready_memory(n, dis);
 		pos = m_first_ + pos_front;
+		if(trivially_relocatable) {
+			pos = open_gap(pos, n, dis);
+			try {
+				construct_blocks(pos, n, first);
+			} catch(...) {
+				close_gap(pos, n, dis);
+				throw;
+			}
+			commit_gap(n, dis);
+			return pos;
+		}
 		if(dis) {
 			auto move_number = pos_front;
 
@@ -775,9 +1117,24 @@ public:
 	iterator erase(iterator first, iterator last) {
 		difference_type pos_front = first - begin();
 		difference_type pos_back = end() - last;
-		difference_type n = distance(first, last);
+		difference_type n = stl::distance(first, last);
 		bool dis = pos_front < pos_back;
 
+		if(trivially_relocatable) {
+			// 析构被删除的元素后整段搬移较短的一侧
+			for(auto p = first;p != last;++p) {
+				m_buffer_allocator_.destory(p.m_cur_);
+			}
+			if(dis) {
+				relocate_backward(m_first_, first, last);
+				m_first_ += n;
+				return last;
+			}
+			relocate_forward(last, m_last_, first);
+			m_last_ -= n;
+			return first;
+		}
+
 		if(dis) {
 			for(auto i = first;i != m_first_;--i) {
 				*(i + n - 1) = std::move(*(i - 1));
@@ -798,6 +1155,8 @@ public:
 			for(auto p = m_last_;p != tmp;++p) {
 				m_buffer_allocator_.destory(p.m_cur_);
 			}
+			// 后方元素前移，被删除区间之后的元素位于first
+			return first;
 		}
 		return last;
 	}
@@ -811,6 +1170,14 @@ public:
 	}
 }; // class Deque 
 
+template <typename T, size_t BufferSize, typename ALLOC>
+constexpr bool Deque<T, BufferSize, ALLOC>::trivially_relocatable;
+
+// Deque的迭代器均指向堆上的缓冲区与映射表，可按位搬移
+template <typename T, size_t BufferSize, typename ALLOC>
+struct is_trivially_relocatable<Deque<T, BufferSize, ALLOC>> :members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<Deque<T, BufferSize, ALLOC>>
+
 } // namespace stl
 
 #endif // _DEQUE_HPP__
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef _GROWTH_POLICY_HPP__
+#define _GROWTH_POLICY_HPP__
+
+/**
+ * 向量的扩容策略
+ * 策略提供grow(cap, need, size)，由当前容量cap与所需容量need计算新容量，size为元素字节数，
+ * 按大小类取整由配置器的allocate_at_least负责，策略无需关心
+*/
+
+#include <cstddef>
+
+namespace stl {
+
+// 倍增，初次分配恰好满足所需
+struct DoubleGrowth {
+	static inline size_t grow(size_t cap, size_t need, size_t) {
+		if(need == 0) {
+			return 1;
+		}
+		if(cap == 0) {
+			return need;
+		}
+		while(cap < need) {
+			cap <<= 1;
+		}
+		return cap;
+	}
+}; // struct DoubleGrowth
+
+// 1.5倍增长，此前释放的内存之和终将足以容纳新容量，便于配置器复用
+struct OneAndHalfGrowth {
+	static inline size_t grow(size_t cap, size_t need, size_t) {
+		if(need == 0) {
+			return 1;
+		}
+		if(cap == 0) {
+			return need;
+		}
+		while(cap < need) {
+			cap += cap / 2 + 1;
+		}
+		return cap;
+	}
+}; // struct OneAndHalfGrowth
+
+// 不足一个Chunk字节时倍增，此后按整块线性增长，大向量的空闲部分不超过一块
+template <size_t Chunk = 64 * 1024 * 1024>
+struct ChunkedGrowth {
+	static_assert(Chunk > 0, "chunk size must be positive");
+
+	static inline size_t grow(size_t cap, size_t need, size_t size) {
+		size_t chunk = Chunk / size > 0 ? Chunk / size : 1;
+		size_t ncap = DoubleGrowth::grow(cap, need < chunk ? need : chunk, size);
+		if(need <= ncap) {
+			return ncap;
+		}
+		return (need + chunk - 1) / chunk * chunk;
+	}
+}; // struct ChunkedGrowth
+
+} // namespace stl
+
+#endif // _GROWTH_POLICY_HPP__
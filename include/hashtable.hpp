@@ -127,8 +127,10 @@ private:
 	using map_type = link_type *;
 	using self = HashTable<Key, Value, KeyOfValue, Hash, H2, KeyEqual, ALLOC>;
 
-	typename ALLOC::template rebind<HashTableListNode<Value,
-		KeyOfValue, Hash>>::other m_node_allocator_;
+	using node_allocator = typename ALLOC::template rebind<HashTableListNode<Value,
+		KeyOfValue, Hash>>::other;
+
+	node_allocator m_node_allocator_;
 	typename ALLOC::template rebind<HashTableListNode<Value,
 		KeyOfValue, Hash> *>::other m_node_ptr_allocator_;
 
@@ -239,9 +241,18 @@ public:
 		m_head_(nullptr, m_map_, m_map_ + bucket_count()), m_tail_(m_head_) {
 	}
 
-	HashTable(const self &ht) :m_size_(ht.size()), m_map_size_index_(ht.m_map_size_index_),
+	explicit HashTable(const ALLOC &allocator) :
+		m_node_allocator_(allocator), m_node_ptr_allocator_(allocator),
+		m_size_(0), m_map_size_index_(0), m_map_(__get_a_map_with(bucket_count())),
+		m_head_(nullptr, m_map_, m_map_ + bucket_count()), m_tail_(m_head_) {
+	}
+
+	HashTable(const self &ht) :
+		m_node_allocator_(ht.m_node_allocator_), m_node_ptr_allocator_(ht.m_node_ptr_allocator_),
+		m_size_(ht.size()), m_map_size_index_(ht.m_map_size_index_),
 		m_map_(__get_a_map_with(bucket_count())),
 		m_head_(nullptr, m_map_, m_map_ + bucket_count()), m_tail_(m_head_) {
+		allocator_traits<node_allocator>::reserve(m_node_allocator_, ht.m_size_);
 		for(size_type i = 0;i < bucket_count();++i) {
 			m_map_[i] = __copy_a_link(ht.m_map_[i]);
 			if(m_head_.base() == nullptr && m_map_[i] != nullptr) {
@@ -250,12 +261,14 @@ public:
 		}
 	}
 
-	HashTable(self &&ht) :m_size_(ht.m_size_), m_map_size_index_(ht.m_map_size_index_),
+	HashTable(self &&ht) :
+		m_node_allocator_(ht.m_node_allocator_), m_node_ptr_allocator_(ht.m_node_ptr_allocator_),
+		m_size_(ht.m_size_), m_map_size_index_(ht.m_map_size_index_),
 		m_map_(ht.m_map_), m_head_(ht.m_head_), m_tail_(ht.m_tail_) {
 		ht.m_size_ = 0;
-		m_map_size_index_ = 0;
+		ht.m_map_size_index_ = 0;
 		ht.m_map_ = ht.__get_a_map_with(ht.bucket_count());
-		m_head_ = m_tail_ = iterator(nullptr, ht.m_map_, ht.m_map_ + ht.bucket_count());
+		ht.m_head_ = ht.m_tail_ = iterator(nullptr, ht.m_map_, ht.m_map_ + ht.bucket_count());
 	}
 
 	self &operator=(const self &ht) {
@@ -269,6 +282,7 @@ public:
 			m_map_ = __get_a_map_with(bucket_count());
 			m_head_ = m_tail_ = iterator(nullptr, m_map_, m_map_ + bucket_count());
 
+			allocator_traits<node_allocator>::reserve(m_node_allocator_, ht.m_size_);
 			for(size_type i = 0;i < bucket_count();++i) {
 				m_map_[i] = __copy_a_link(ht.m_map_[i]);
 				if(m_head_.base() == nullptr && m_map_[i] != nullptr) {
@@ -282,19 +296,7 @@ public:
 	self &operator=(self &&ht) {
 		if(this != &ht) {
 			clear();
-
-			map_type p = m_map_;
-
-			m_size_ = ht.m_size_;
-			m_map_size_index_ = ht.m_map_size_index_;
-			m_map_ = ht.m_map_;
-			m_head_ = ht.m_head_;
-			m_tail_ = ht.m_tail_;
-
-			ht.m_size_ = 0;
-			m_map_size_index_ = 0;
-			ht.m_map_ = p;
-			m_head_ = m_tail_ = iterator(nullptr, ht.m_map_, ht.m_map_ + ht.bucket_count());
+			swap(ht);
 		}
 		return *this;
 	}
@@ -323,7 +325,15 @@ public:
 	}
 
 	void swap(self &ht) {
-		stl::swap(*this, ht);
+		if(this != &ht) {
+			std::swap(m_node_allocator_, ht.m_node_allocator_);
+			std::swap(m_node_ptr_allocator_, ht.m_node_ptr_allocator_);
+			std::swap(m_size_, ht.m_size_);
+			std::swap(m_map_size_index_, ht.m_map_size_index_);
+			std::swap(m_map_, ht.m_map_);
+			std::swap(m_head_, ht.m_head_);
+			std::swap(m_tail_, ht.m_tail_);
+		}
 	}
 
 	inline size_type size() const {
@@ -548,6 +558,13 @@ public:
 	}
 }; // class HashTable
 
+// 桶数组与结点均位于堆上，可按位搬移
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+	typename H2, typename KeyEqual, typename ALLOC>
+struct is_trivially_relocatable<HashTable<Key, Value, KeyOfValue, Hash, H2, KeyEqual, ALLOC>> :
+	members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<HashTable<Key, Value, KeyOfValue, Hash, H2, KeyEqual, ALLOC>>
+
 } // namespace stl
 
 
@@ -3,6 +3,8 @@
 
 #include <stddef.h>
 
+#include "type_traits.hpp"
+
 namespace stl {
 
 // 迭代器类型
@@ -149,6 +151,15 @@ inline void advance(InputIterator &i, Distance n) {
 	__advance(i, n, iterator_category(i));
 }
 
+// 分段迭代器萃取，默认不分段
+// 由若干连续内存段组成的容器可特化该模板，提供以下成员，算法据此逐段以局部迭代器遍历：
+// is_segmented为true_type，segment_iterator遍历各段，local_iterator遍历段内元素，
+// segment(i)与local(i)分解迭代器，begin(s)与end(s)为段的范围，compose(s, l)由两者合成迭代器
+template <typename I>
+struct segmented_iterator_traits {
+	using is_segmented = false_type;
+}; // struct segmented_iterator_traits
+
 } // namespace stl
 
 #endif // _ITERATOR_HPP__
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "uninitialized.hpp"
 #include "functional.hpp"
 #include "reverse_iterator.hpp"
+#include "type_traits.hpp"
 
 namespace stl {
 
@@ -114,7 +115,9 @@ public:
 	using reverse_iterator = ReverseIterator<iterator>;
 	using const_reverse_iterator = const ReverseIterator<iterator>;
 private:
-	typename ALLOC::template rebind<Node<T>>::other m_allocator_;
+	using node_allocator = typename ALLOC::template rebind<Node<T>>::other;
+
+	node_allocator m_allocator_;
 
 	iterator m_head_;
 	iterator m_tail_;
@@ -124,6 +127,8 @@ private:
 		if(n == 0) {
 			return;
 		}
+		// 构造时另需一个尾结点
+		allocator_traits<node_allocator>::reserve(m_allocator_, n + 1);
 		head = iterator(m_allocator_.allocate(1));
 		tail = head;
 		--n;
@@ -160,6 +165,12 @@ public:
 		m_head_.m_ptr_->m_next_ = nullptr;
 	}
 
+	explicit List(const ALLOC &allocator) :
+		m_allocator_(allocator), m_head_(m_allocator_.allocate(1)), m_tail_(m_head_), m_length_(0) {
+		m_head_.m_ptr_->m_prev_ = nullptr;
+		m_head_.m_ptr_->m_next_ = nullptr;
+	}
+
 	explicit List(size_type n) :m_length_(n) {
 		create_memory(m_head_, m_tail_, n);
 		if(n) {
@@ -204,7 +215,7 @@ public:
 		uninitialized_copy(first, last, m_head_, m_allocator_);
 	}
 
-	List(const List<T, ALLOC> &list) :m_length_(list.size()) {
+	List(const List<T, ALLOC> &list) :m_allocator_(list.m_allocator_), m_length_(list.size()) {
 		create_memory(m_head_, m_tail_, m_length_);
 		if(m_length_) {
 			m_tail_.m_ptr_->m_next_ = m_allocator_.allocate(1);
@@ -219,7 +230,7 @@ public:
 	}
 
 	List(List<T, ALLOC> &&list) :
-		m_head_(list.m_head_), m_tail_(list.m_tail_), m_length_(list.m_length_) {
+		m_allocator_(list.m_allocator_), m_head_(list.m_head_), m_tail_(list.m_tail_), m_length_(list.m_length_) {
 		list.m_head_ = iterator(m_allocator_.allocate(1));
 		list.m_tail_ = list.m_head_;
 		list.m_length_ = 0;
@@ -275,6 +286,7 @@ public:
 
 	void swap(List<T, ALLOC> &l) {
 		if(this != &l) {
+			std::swap(l.m_allocator_, m_allocator_);
 			std::swap(l.m_head_, m_head_);
 			std::swap(l.m_tail_, m_tail_);
 			std::swap(l.m_length_, m_length_);
@@ -717,6 +729,11 @@ public:
 	}
 }; // class List
 
+// List的头尾结点均位于堆上，对象本身可按位搬移
+template <typename T, typename ALLOC>
+struct is_trivially_relocatable<List<T, ALLOC>> :members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<List<T, ALLOC>>
+
 
 template <typename U, typename P>
 void swap(List<U, P> &v, List<U, P> &vv) {
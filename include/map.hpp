@@ -41,6 +41,12 @@ public:
 	explicit Map(const Compare &comp = Compare()) :m_rb_tree_(comp) {
 	}
 
+	explicit Map(const ALLOC &allocator) :m_rb_tree_(Compare(), allocator) {
+	}
+
+	Map(const Compare &comp, const ALLOC &allocator) :m_rb_tree_(comp, allocator) {
+	}
+
 	Map(const Map &other) :m_rb_tree_(other.m_rb_tree_) {
 	}
 
@@ -130,6 +136,7 @@ public:
 
 	template <typename InputIterator>
 	void insert(InputIterator first, InputIterator last) {
+		m_rb_tree_.reserve_nodes(first, last);
 		for(;first != last;++first) {
 			m_rb_tree_.insert_unique(*first);
 		}
@@ -207,6 +214,12 @@ public:
 	explicit MultiMap(const Compare &comp = Compare()) :m_rb_tree_(comp) {
 	}
 
+	explicit MultiMap(const ALLOC &allocator) :m_rb_tree_(Compare(), allocator) {
+	}
+
+	MultiMap(const Compare &comp, const ALLOC &allocator) :m_rb_tree_(comp, allocator) {
+	}
+
 	MultiMap(const MultiMap &other) :m_rb_tree_(other.m_rb_tree_) {
 	}
 
@@ -283,6 +296,7 @@ public:
 
 	template <typename InputIterator>
 	void insert(InputIterator first, InputIterator last) {
+		m_rb_tree_.reserve_nodes(first, last);
 		for(;first != last;++first) {
 			m_rb_tree_.insert_equal(*first);
 		}
@@ -331,6 +345,15 @@ public:
 	}
 }; // class MultiMap
 
+// 仅持有一棵红黑树，与红黑树同样可按位搬移
+template <typename Key, typename Value, typename Compare, typename ALLOC>
+struct is_trivially_relocatable<Map<Key, Value, Compare, ALLOC>> :members_trivially_relocatable<Compare, ALLOC> {
+}; // struct is_trivially_relocatable<Map<Key, Value, Compare, ALLOC>>
+
+template <typename Key, typename Value, typename Compare, typename ALLOC>
+struct is_trivially_relocatable<MultiMap<Key, Value, Compare, ALLOC>> :members_trivially_relocatable<Compare, ALLOC> {
+}; // struct is_trivially_relocatable<MultiMap<Key, Value, Compare, ALLOC>>
+
 } // namespace stl
 
 #endif // _MAP_HPP__
\ No newline at end of file
@@ -0,0 +1,335 @@
+#ifndef _MEMORY_RESOURCE_HPP__
+#define _MEMORY_RESOURCE_HPP__
+
+/**
+ * 多态内存资源
+ * 容器使用PolymorphicAllocator时，内存来源由运行时传入的MemoryResource决定，
+ * 使用不同内存资源的容器仍为同一类型
+*/
+
+#include <new>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+
+#include <stdint.h>
+
+#include <cassert>
+
+#include "arena.hpp"
+
+namespace stl {
+
+// 内存资源基类
+class MemoryResource {
+public:
+	using size_type = size_t;
+
+	static constexpr size_type max_align = alignof(std::max_align_t);
+
+	virtual ~MemoryResource() = default;
+
+	// 分配n字节内存，按align对齐
+	inline void *allocate(size_type n, size_type align = max_align) {
+		return do_allocate(n, align);
+	}
+
+	// 回收n字节内存
+	inline void deallocate(void *p, size_type n, size_type align = max_align) {
+		do_deallocate(p, n, align);
+	}
+
+	// 判断由一方分配的内存能否由另一方回收
+	inline bool is_equal(const MemoryResource &other) const {
+		return do_is_equal(other);
+	}
+protected:
+	virtual void *do_allocate(size_type n, size_type align) = 0;
+	virtual void do_deallocate(void *p, size_type n, size_type align) = 0;
+
+	virtual bool do_is_equal(const MemoryResource &other) const {
+		return this == &other;
+	}
+}; // class MemoryResource
+
+inline bool operator==(const MemoryResource &a, const MemoryResource &b) {
+	return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(const MemoryResource &a, const MemoryResource &b) {
+	return !(a == b);
+}
+
+// 使用::operator new/delete的内存资源
+class NewDeleteResource :public MemoryResource {
+protected:
+	void *do_allocate(size_type n, size_type align) override {
+		assert(align <= max_align);
+		return ::operator new(n);
+	}
+
+	void do_deallocate(void *p, size_type, size_type) override {
+		::operator delete(p);
+	}
+
+	bool do_is_equal(const MemoryResource &other) const override {
+		return dynamic_cast<const NewDeleteResource *>(&other) != nullptr;
+	}
+}; // class NewDeleteResource
+
+// 获取全局唯一的NewDeleteResource
+inline MemoryResource *new_delete_resource() {
+	static NewDeleteResource resource;
+	return &resource;
+}
+
+// 保存默认内存资源
+inline std::atomic<MemoryResource *> &default_resource() {
+	static std::atomic<MemoryResource *> resource(nullptr);
+	return resource;
+}
+
+// 获取默认内存资源，未设置时为new_delete_resource()
+inline MemoryResource *get_default_resource() {
+	MemoryResource *res = default_resource().load(std::memory_order_acquire);
+	return res == nullptr ? new_delete_resource() : res;
+}
+
+// 设置默认内存资源，返回之前的默认内存资源
+inline MemoryResource *set_default_resource(MemoryResource *res) {
+	MemoryResource *prev = default_resource().exchange(res, std::memory_order_acq_rel);
+	return prev == nullptr ? new_delete_resource() : prev;
+}
+
+// 单调内存资源，回收操作不归还内存，release时一次性释放
+class MonotonicResource :public MemoryResource {
+	Arena m_arena_;
+public:
+	explicit MonotonicResource(size_type block_size = Arena::default_block_size) :
+		m_arena_(block_size) {
+	}
+
+	MonotonicResource(const MonotonicResource &) = delete;
+	MonotonicResource &operator=(const MonotonicResource &) = delete;
+
+	// 释放全部内存
+	void release() {
+		m_arena_.release();
+	}
+
+	// 获取底层区域，可用于设置检查点
+	Arena &arena() {
+		return m_arena_;
+	}
+protected:
+	void *do_allocate(size_type n, size_type align) override {
+		return m_arena_.allocate(n, align);
+	}
+
+	void do_deallocate(void *p, size_type n, size_type) override {
+		m_arena_.deallocate(p, n);
+	}
+}; // class MonotonicResource
+
+// 池式内存资源，小块内存按2的幂划分大小类，各类维护空闲链表，非线程安全
+class PoolResource :public MemoryResource {
+public:
+	static constexpr size_type min_block_size = 16;
+	static constexpr size_type pool_level = 8;
+	static constexpr size_type max_block_size = min_block_size << (pool_level - 1);
+	static constexpr size_type default_chunk_size = 64 * 1024;
+private:
+	struct FreeBlock {
+		FreeBlock *m_next_;
+	}; // struct FreeBlock
+
+	// 向上游申请的内存块，按申请顺序组成单链表
+	struct Chunk {
+		Chunk *m_next_;
+		size_type m_size_;
+	}; // struct Chunk
+
+	static_assert(sizeof(Chunk) % alignof(std::max_align_t) == 0, "chunk header misaligned");
+
+	MemoryResource *m_upstream_;
+	FreeBlock *m_free_list_[pool_level];
+	Chunk *m_chunk_list_;
+	size_type m_chunk_size_;
+
+	// 获取容纳n字节所需的大小类
+	static inline size_type level_of(size_type n) {
+		size_type level = 0;
+		while((min_block_size << level) < n) {
+			++level;
+		}
+		return level;
+	}
+
+	// 向上游申请一块内存，切分后挂入第level层空闲链表
+	void refill(size_type level) {
+		size_type block_size = min_block_size << level;
+		size_type size = m_chunk_size_ < block_size ? block_size : m_chunk_size_;
+		Chunk *chunk = static_cast<Chunk *>(
+			m_upstream_->allocate(sizeof(Chunk) + size, max_align));
+		chunk->m_next_ = m_chunk_list_;
+		chunk->m_size_ = size;
+		m_chunk_list_ = chunk;
+
+		char *first = reinterpret_cast<char *>(chunk + 1);
+		char *last = first + size / block_size * block_size;
+		for(char *p = last - block_size;;p -= block_size) {
+			FreeBlock *block = reinterpret_cast<FreeBlock *>(p);
+			block->m_next_ = m_free_list_[level];
+			m_free_list_[level] = block;
+			if(p == first) {
+				break;
+			}
+		}
+	}
+public:
+	explicit PoolResource(MemoryResource *upstream = get_default_resource(),
+		size_type chunk_size = default_chunk_size) :
+		m_upstream_(upstream),
+		m_free_list_{ nullptr },
+		m_chunk_list_(nullptr),
+		m_chunk_size_(chunk_size) {
+	}
+
+	PoolResource(const PoolResource &) = delete;
+	PoolResource &operator=(const PoolResource &) = delete;
+
+	~PoolResource() {
+		release();
+	}
+
+	// 将全部内存归还上游
+	void release() {
+		while(m_chunk_list_ != nullptr) {
+			Chunk *next = m_chunk_list_->m_next_;
+			m_upstream_->deallocate(m_chunk_list_, sizeof(Chunk) + m_chunk_list_->m_size_, max_align);
+			m_chunk_list_ = next;
+		}
+		for(size_type i = 0;i < pool_level;++i) {
+			m_free_list_[i] = nullptr;
+		}
+	}
+
+	MemoryResource *upstream_resource() const {
+		return m_upstream_;
+	}
+protected:
+	void *do_allocate(size_type n, size_type align) override {
+		if(n > max_block_size || align > max_align) {
+			return m_upstream_->allocate(n, align);
+		}
+		size_type level = level_of(n);
+		if(m_free_list_[level] == nullptr) {
+			refill(level);
+		}
+		FreeBlock *block = m_free_list_[level];
+		m_free_list_[level] = block->m_next_;
+		return block;
+	}
+
+	void do_deallocate(void *p, size_type n, size_type align) override {
+		if(n > max_block_size || align > max_align) {
+			m_upstream_->deallocate(p, n, align);
+			return;
+		}
+		size_type level = level_of(n);
+		FreeBlock *block = static_cast<FreeBlock *>(p);
+		block->m_next_ = m_free_list_[level];
+		m_free_list_[level] = block;
+	}
+}; // class PoolResource
+
+// 多态空间配置器，默认构造时使用默认内存资源
+template <typename T>
+class PolymorphicAllocator {
+public:
+	// 定义类型
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = size_t;
+	using difference_type = ::ptrdiff_t;
+
+	// 嵌套类型
+	template <typename U>
+	struct rebind {
+		using other = PolymorphicAllocator<U>;
+	}; // struct rebind
+private:
+	MemoryResource *m_resource_;
+public:
+	// 构造函数
+	PolymorphicAllocator() :m_resource_(get_default_resource()) {
+	}
+
+	PolymorphicAllocator(MemoryResource *resource) :m_resource_(resource) {
+		assert(resource != nullptr);
+	}
+
+	PolymorphicAllocator(const PolymorphicAllocator &) = default;
+	~PolymorphicAllocator() = default;
+
+	template<typename U>
+	PolymorphicAllocator(const PolymorphicAllocator<U> &u) :m_resource_(u.resource()) {
+	}
+
+	// 获取对象地址
+	inline pointer address(reference x) const {
+		return static_cast<pointer>(&x);
+	}
+
+	inline const_pointer address(const_reference x) const {
+		return static_cast<const_pointer>(&x);
+	}
+
+	// 分配内存空间
+	pointer allocate(size_type n, const void * = nullptr) {
+		return static_cast<pointer>(m_resource_->allocate(n * sizeof(value_type), alignof(value_type)));
+	}
+
+	// 释放内存空间
+	void deallocate(pointer p, size_type n) {
+		m_resource_->deallocate(p, n * sizeof(value_type), alignof(value_type));
+	}
+
+	// 对象最大数量
+	size_type max_size() const {
+		return static_cast<size_type>(UINT32_MAX / sizeof(value_type));
+	}
+
+	// 使用对应指针进行构造
+	template <typename ... Args>
+	void construct(pointer p, Args&& ... x) {
+		new(p) value_type(std::forward<Args>(x)...);
+	}
+
+	// 使用对应指针进行析构
+	void destory(pointer p) {
+		p->~value_type();
+	}
+
+	// 获取内存资源
+	inline MemoryResource *resource() const {
+		return m_resource_;
+	}
+}; // class PolymorphicAllocator
+
+template <typename T, typename U>
+inline bool operator==(const PolymorphicAllocator<T> &a, const PolymorphicAllocator<U> &b) {
+	return *a.resource() == *b.resource();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const PolymorphicAllocator<T> &a, const PolymorphicAllocator<U> &b) {
+	return !(a == b);
+}
+
+} // namespace stl
+
+#endif // _MEMORY_RESOURCE_HPP__
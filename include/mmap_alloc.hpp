@@ -0,0 +1,124 @@
+#ifndef _MMAP_ALLOC_HPP__
+#define _MMAP_ALLOC_HPP__
+
+#include <new>
+#include <cstddef>
+
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cassert>
+
+namespace stl {
+
+// 大块内存直接通过mmap向系统申请，并请求透明大页
+class MmapAlloc {
+public:
+	using size_type = size_t;
+	using difference_type = ::ptrdiff_t;
+
+	// 不小于该大小的请求使用mmap
+	static constexpr size_type mmap_threshold = 1024 * 1024;
+	// 透明大页大小
+	static constexpr size_type huge_page_size = 2 * 1024 * 1024;
+private:
+	static inline size_type page_size() {
+		static const size_type size = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+		return size;
+	}
+
+	// 将n向上取整为align的倍数，align须为2的幂
+	static inline size_type round_up(size_type n, size_type align) {
+		return (n + align - 1) & ~(align - 1);
+	}
+
+	// 对不小于大页的区域请求透明大页
+	static inline void advise_huge_page(void *p, size_type n) {
+#ifdef MADV_HUGEPAGE
+		if(n >= huge_page_size) {
+			::madvise(p, n, MADV_HUGEPAGE);
+		}
+#endif // MADV_HUGEPAGE
+	}
+public:
+	// 映射时实际占用的字节数
+	static inline size_type mapped_size(size_type n) {
+		return round_up(n, page_size());
+	}
+
+	// 分配n字节内存，不小于大页时按大页对齐
+	void *allocate(size_type n, const void * = nullptr) {
+		size_type size = mapped_size(n);
+		size_type extra = size >= huge_page_size ? huge_page_size : 0;
+
+		void *mem = ::mmap(nullptr, size + extra, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(mem == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+
+		char *p = static_cast<char *>(mem);
+		if(extra != 0) {
+			// 裁去首尾多余部分，使起始地址按大页对齐
+			char *aligned = reinterpret_cast<char *>(round_up(reinterpret_cast<uintptr_t>(p), huge_page_size));
+			if(aligned != p) {
+				::munmap(p, aligned - p);
+			}
+			size_type tail = (p + size + extra) - (aligned + size);
+			if(tail != 0) {
+				::munmap(aligned + size, tail);
+			}
+			p = aligned;
+		}
+
+		advise_huge_page(p, size);
+		return p;
+	}
+
+	// 回收n字节内存
+	void deallocate(void *p, size_type n) {
+		::munmap(p, mapped_size(n));
+	}
+
+	// 不移动映射地将old_n字节扩展为new_n字节，失败返回false
+	bool expand(void *p, size_type old_n, size_type new_n) {
+#ifdef MREMAP_MAYMOVE
+		size_type old_size = mapped_size(old_n);
+		size_type new_size = mapped_size(new_n);
+		if(new_size <= old_size) {
+			return true;
+		}
+		if(::mremap(p, old_size, new_size, 0) == MAP_FAILED) {
+			return false;
+		}
+		advise_huge_page(p, new_size);
+		return true;
+#else
+		return false;
+#endif // MREMAP_MAYMOVE
+	}
+
+	// 将old_n字节的映射扩展或收缩为new_n字节，必要时由内核移动映射，失败返回nullptr
+	void *reallocate(void *p, size_type old_n, size_type new_n) {
+#ifdef MREMAP_MAYMOVE
+		size_type old_size = mapped_size(old_n);
+		size_type new_size = mapped_size(new_n);
+		if(old_size == new_size) {
+			return p;
+		}
+		void *mem = ::mremap(p, old_size, new_size, MREMAP_MAYMOVE);
+		if(mem == MAP_FAILED) {
+			return nullptr;
+		}
+		advise_huge_page(mem, new_size);
+		return mem;
+#else
+		return nullptr;
+#endif // MREMAP_MAYMOVE
+	}
+}; // class MmapAlloc
+
+} // namespace stl
+
+#endif // _MMAP_ALLOC_HPP__
@@ -6,14 +6,36 @@
 
 namespace stl {
 
-template <typename InputIterator, typename T, typename BOP = plus<T>>
-T accumulate(InputIterator first, InputIterator last, T init, BOP bop = BOP()) {
+template <typename InputIterator, typename T, typename BOP>
+static T __accumulate(InputIterator first, InputIterator last, T init, BOP bop, false_type) {
 	for(;first != last;++first) {
 		init = std::move(bop(init, *first));
 	}
 	return std::move(init);
 }
 
+// 分段迭代器逐段累加
+template <typename InputIterator, typename T, typename BOP>
+static T __accumulate(InputIterator first, InputIterator last, T init, BOP bop, true_type) {
+	using traits = segmented_iterator_traits<InputIterator>;
+	auto sf = traits::segment(first);
+	auto sl = traits::segment(last);
+	if(sf == sl) {
+		return __accumulate(traits::local(first), traits::local(last), std::move(init), bop, false_type());
+	}
+	init = __accumulate(traits::local(first), traits::end(sf), std::move(init), bop, false_type());
+	for(++sf;sf != sl;++sf) {
+		init = __accumulate(traits::begin(sf), traits::end(sf), std::move(init), bop, false_type());
+	}
+	return __accumulate(traits::begin(sl), traits::local(last), std::move(init), bop, false_type());
+}
+
+template <typename InputIterator, typename T, typename BOP = plus<T>>
+T accumulate(InputIterator first, InputIterator last, T init, BOP bop = BOP()) {
+	return __accumulate(first, last, std::move(init), bop,
+		typename segmented_iterator_traits<InputIterator>::is_segmented());
+}
+
 template <typename InputIterator, typename OutputIterator>
 OutputIterator adjacent_difference(InputIterator first, InputIterator last,
 	OutputIterator d_first) {
@@ -6,6 +6,7 @@
 #include "allocator.hpp"
 #include "utility.hpp"
 #include "reverse_iterator.hpp"
+#include "type_traits.hpp"
 
 namespace stl {
 
@@ -407,7 +408,9 @@ public:
 	static constexpr rb_color rb_red = RBNodeBase::rb_node_red;
 	static constexpr rb_color rb_black = RBNodeBase::rb_node_black;
 protected:
-	typename ALLOC::template rebind<RBNode<value_type>>::other m_allocator_;
+	using node_allocator = typename ALLOC::template rebind<RBNode<value_type>>::other;
+
+	node_allocator m_allocator_;
 
 	size_type m_size_;
 	link_type m_head_;
@@ -551,7 +554,15 @@ public:
 		init();
 	}
 
-	RBTree(const RBTree &rbt) :RBTree() {
+	RBTree(const Compare &comp, const ALLOC &allocator) :
+		m_allocator_(allocator), m_size_(0), m_head_(nullptr), m_comparator_(comp) {
+		init();
+	}
+
+	RBTree(const RBTree &rbt) :
+		m_allocator_(rbt.m_allocator_), m_size_(0), m_head_(nullptr), m_comparator_(rbt.m_comparator_) {
+		init();
+		reserve_nodes(rbt.m_size_);
 		root() = clone(m_head_, rbt.root());
 		if(root() == nullptr) {
 			return;
@@ -562,7 +573,7 @@ public:
 	}
 
 	RBTree(RBTree &&rbt) :
-		m_size_(rbt.m_size_), m_head_(rbt.m_head_), m_comparator_(rbt.m_comparator_) {
+		m_allocator_(rbt.m_allocator_), m_size_(rbt.m_size_), m_head_(rbt.m_head_), m_comparator_(rbt.m_comparator_) {
 		rbt.m_size_ = 0;
 		rbt.m_head_ = nullptr;
 		rbt.init();
@@ -577,6 +588,7 @@ public:
 		if(this != &rb) {
 			clear();
 
+			reserve_nodes(rb.m_size_);
 			root() = clone(m_head_, rb.root());
 			if(root() == nullptr) {
 				return *this;
@@ -638,6 +650,26 @@ public:
 		return m_size_ == 0;;
 	}
 
+	// 提示即将插入n个结点，配置器支持时预先批量备好
+	void reserve_nodes(size_type n) {
+		allocator_traits<node_allocator>::reserve(m_allocator_, n);
+	}
+
+	// 区间插入前的预留，仅前向及更强的迭代器可预先求出长度，输入迭代器只能遍历一次，不做预留
+	template <typename InputIterator>
+	void reserve_nodes(InputIterator first, InputIterator last) {
+		reserve_nodes(first, last, iterator_category(first));
+	}
+
+	template <typename InputIterator>
+	void reserve_nodes(InputIterator, InputIterator, input_iterator_tag) {
+	}
+
+	template <typename ForwardIterator>
+	void reserve_nodes(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+		reserve_nodes(stl::distance(first, last));
+	}
+
 	iterator find(const key_type &value) const {
 		iterator tmp = lower_bound(value);
 		return (tmp == end() || compare_kv(value, *tmp)) ? end() : tmp;
@@ -1120,6 +1152,12 @@ protected:
 	}
 }; // class RBTree
 
+// 头结点位于堆上，根结点的父指针不指向树对象本身，可按位搬移
+template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename ALLOC>
+struct is_trivially_relocatable<RBTree<Key, Value, KeyOfValue, Compare, ALLOC>> :
+	members_trivially_relocatable<KeyOfValue, Compare, ALLOC> {
+}; // struct is_trivially_relocatable<RBTree<Key, Value, KeyOfValue, Compare, ALLOC>>
+
 } // namespace stl
 
 
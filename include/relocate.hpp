@@ -0,0 +1,246 @@
+#ifndef _RELOCATE_HPP__
+#define _RELOCATE_HPP__
+
+/**
+ * 连续存储容器共用的元素搬移与在位增删
+ * Vector、SmallVector与StaticVector的元素均位于连续内存[first, last)中，
+ * 以下函数只操作指针区间与配置器，首尾指针与容量由容器自行维护；
+ * 可按位搬移的类型整段搬移内存，构造新元素抛出异常时将已搬移的元素移回原处
+*/
+
+#include <utility>
+
+#include <string.h>
+
+#include "iterator.hpp"
+#include "uninitialized.hpp"
+#include "type_traits.hpp"
+
+namespace stl {
+
+// 将[pos, last)整段后移n个位置，空出的[pos, pos + n)未构造
+template <typename T>
+inline void open_gap(T *pos, T *last, size_t n) {
+	if(pos != last) {
+		::memmove(static_cast<void *>(pos + n), static_cast<const void *>(pos), (last - pos) * sizeof(T));
+	}
+}
+
+// 在空位中构造新元素失败时，将已后移n个位置的[pos, last)移回原处，last为后移前的尾部
+template <typename T>
+inline void close_gap(T *pos, T *last, size_t n) {
+	if(pos != last) {
+		::memmove(static_cast<void *>(pos), static_cast<const void *>(pos + n), (last - pos) * sizeof(T));
+	}
+}
+
+namespace {
+
+// 可按位搬移的类型整段复制内存，原位置的对象随之结束生命期
+template <typename T, typename Alloc>
+inline void __relocate_range(T *first, T *pos, T *last, T *result, size_t gap, Alloc, true_type) {
+	if(first != pos) {
+		::memcpy(static_cast<void *>(result), static_cast<const void *>(first), (pos - first) * sizeof(T));
+	}
+	if(pos != last) {
+		::memcpy(static_cast<void *>(result + (pos - first) + gap), static_cast<const void *>(pos),
+			(last - pos) * sizeof(T));
+	}
+}
+
+// 移动构造不抛出异常时移动，否则复制，全部构造成功后才析构原有元素
+template <typename T, typename Alloc>
+inline void __relocate_range(T *first, T *pos, T *last, T *result, size_t gap, Alloc allocator, false_type) {
+	size_t dis = pos - first;
+	try {
+		uninitialized_move_if_noexcept(first, pos, result, allocator);
+	} catch(...) {
+		initialized_destory(result + dis, result + dis + gap, allocator);
+		throw;
+	}
+	try {
+		uninitialized_move_if_noexcept(pos, last, result + dis + gap, allocator);
+	} catch(...) {
+		initialized_destory(result, result + dis + gap, allocator);
+		throw;
+	}
+	initialized_destory(first, last, allocator);
+}
+
+// elem位于后移的区间内时随之后移
+template <typename T, typename Alloc>
+inline void __inplace_insert_fill(T *pos, T *last, size_t n, const T &elem, Alloc allocator, true_type) {
+	const T *src = &elem;
+	if(src >= pos && src < last) {
+		src += n;
+	}
+	open_gap(pos, last, n);
+	try {
+		uninitialized_fill_n(*src, pos, n, allocator);
+	} catch(...) {
+		close_gap(pos, last, n);
+		throw;
+	}
+}
+
+template <typename T, typename Alloc>
+inline void __inplace_insert_fill(T *pos, T *last, size_t n, const T &elem, Alloc allocator, false_type) {
+	// elem位于后移的区间内时先行复制
+	if(&elem >= pos && &elem < last) {
+		T value(elem);
+		__inplace_insert_fill(pos, last, n, value, allocator, false_type());
+		return;
+	}
+	size_t move_number = last - pos;
+	if(move_number > n) {
+		// 构造尾部
+		uninitialized_move(last - n, last, last, allocator);
+
+		// 赋值尾部
+		for(auto i = last - 1;i != pos + n - 1;--i) {
+			*i = std::move(*(i - n));
+		}
+
+		// 赋值中部
+		for(size_t i = 0;i < n;++i) {
+			*(pos + i) = elem;
+		}
+	} else {
+		// 构造尾部
+		uninitialized_move(pos, last, pos + n, allocator);
+
+		// 构造中部
+		uninitialized_fill_n(elem, last, n - move_number, allocator);
+
+		// 赋值中部
+		for(auto p = pos;p != last;++p) {
+			*p = elem;
+		}
+	}
+}
+
+template <typename T, typename Alloc>
+inline void __inplace_insert_move(T *pos, T *last, T &&elem, Alloc allocator, true_type) {
+	open_gap(pos, last, 1);
+	try {
+		allocator.construct(pos, std::move(elem));
+	} catch(...) {
+		close_gap(pos, last, 1);
+		throw;
+	}
+}
+
+template <typename T, typename Alloc>
+inline void __inplace_insert_move(T *pos, T *last, T &&elem, Alloc allocator, false_type) {
+	if(pos == last) {
+		allocator.construct(pos, std::move(elem));
+		return;
+	}
+	allocator.construct(last, std::move(*(last - 1)));
+	for(auto p = last - 1;p != pos;--p) {
+		*p = std::move(*(p - 1));
+	}
+	*pos = std::move(elem);
+}
+
+template <typename T, typename ForwardIterator, typename Alloc>
+inline void __inplace_insert_range(T *pos, T *last, ForwardIterator first, ForwardIterator flast, size_t n,
+	Alloc allocator, true_type) {
+	open_gap(pos, last, n);
+	try {
+		uninitialized_copy(first, flast, pos, allocator);
+	} catch(...) {
+		close_gap(pos, last, n);
+		throw;
+	}
+}
+
+template <typename T, typename ForwardIterator, typename Alloc>
+inline void __inplace_insert_range(T *pos, T *last, ForwardIterator first, ForwardIterator flast, size_t n,
+	Alloc allocator, false_type) {
+	size_t move_number = last - pos;
+	if(move_number > n) {
+		// 构造尾部
+		uninitialized_move(last - n, last, last, allocator);
+
+		// 赋值尾部
+		for(auto i = last - 1;i != pos + n - 1;--i) {
+			*i = std::move(*(i - n));
+		}
+
+		// 赋值中部
+		for(auto p = pos;first != flast;++p, ++first) {
+			*p = *first;
+		}
+	} else {
+		// 构造尾部
+		uninitialized_move(pos, last, pos + n, allocator);
+
+		// 构造中部
+		auto mid = first;
+		stl::advance(mid, move_number);
+		uninitialized_copy(mid, flast, last, allocator);
+
+		// 赋值中部
+		for(auto p = pos;p != last;++p, ++first) {
+			*p = *first;
+		}
+	}
+}
+
+// 析构被删除的元素后整段前移尾部
+template <typename T, typename Alloc>
+inline void __inplace_erase(T *first, T *last, T *end, Alloc allocator, true_type) {
+	initialized_destory(first, last, allocator);
+	if(last != end) {
+		::memmove(static_cast<void *>(first), static_cast<const void *>(last), (end - last) * sizeof(T));
+	}
+}
+
+template <typename T, typename Alloc>
+inline void __inplace_erase(T *first, T *last, T *end, Alloc allocator, false_type) {
+	auto n = last - first;
+	for(auto p = last;p != end;++p) {
+		*(p - n) = std::move(*p);
+	}
+	initialized_destory(end - n, end, allocator);
+}
+
+} // namespace
+
+// 将[first, last)搬移至未构造的内存result，[pos, last)另后移gap个位置，
+// [result + (pos - first), result + (pos - first) + gap)中的新元素须已由调用者构造
+// 搬移抛出异常时析构result中已构造的对象，包括新元素，原有元素保持不变，result由调用者释放
+template <typename T, typename Alloc>
+void relocate_range(T *first, T *pos, T *last, T *result, size_t gap, Alloc allocator) {
+	__relocate_range(first, pos, last, result, gap, allocator, typename is_trivially_relocatable<T>::type());
+}
+
+// 以下函数在[pos, last)之后已有足够的未构造空间时于pos处插入n个新元素，
+// 容器随后将尾部后移n个位置；抛出异常时可按位搬移的类型恢复原状
+
+template <typename T, typename Alloc>
+void inplace_insert_fill(T *pos, T *last, size_t n, const T &elem, Alloc allocator) {
+	__inplace_insert_fill(pos, last, n, elem, allocator, typename is_trivially_relocatable<T>::type());
+}
+
+template <typename T, typename Alloc>
+void inplace_insert_move(T *pos, T *last, T &&elem, Alloc allocator) {
+	__inplace_insert_move(pos, last, std::move(elem), allocator, typename is_trivially_relocatable<T>::type());
+}
+
+// n为[first, flast)的长度
+template <typename T, typename ForwardIterator, typename Alloc>
+void inplace_insert_range(T *pos, T *last, ForwardIterator first, ForwardIterator flast, size_t n, Alloc allocator) {
+	__inplace_insert_range(pos, last, first, flast, n, allocator, typename is_trivially_relocatable<T>::type());
+}
+
+// 删除[first, last)并前移[last, end)，容器随后将尾部前移last - first个位置
+template <typename T, typename Alloc>
+void inplace_erase(T *first, T *last, T *end, Alloc allocator) {
+	__inplace_erase(first, last, end, allocator, typename is_trivially_relocatable<T>::type());
+}
+
+} // namespace stl
+
+#endif // _RELOCATE_HPP__
@@ -0,0 +1,133 @@
+#ifndef _SCATTER_IO_HPP__
+#define _SCATTER_IO_HPP__
+
+/**
+ * 分散/聚集读写
+ * 将容器的存储直接描述为iovec数组，经由writev与readv在文件描述符与容器之间传输，不经过中间缓冲区
+ * 分段迭代器（如Deque）的每个连续内存段对应一个iovec，指针迭代器（如Vector）整体对应一个iovec
+*/
+
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "iterator.hpp"
+#include "small_vector.hpp"
+#include "type_traits.hpp"
+
+namespace stl {
+
+// 单次调用使用的iovec数量上限，取系统的IOV_MAX，未定义时取Linux的1024
+#ifdef IOV_MAX
+constexpr size_t tinystl_iov_max = IOV_MAX;
+#else
+constexpr size_t tinystl_iov_max = 1024;
+#endif
+
+// 栈上直接容纳的iovec数量，段数更多时在堆上分配
+constexpr size_t tinystl_iov_inline = 16;
+
+using iovec_buffer = SmallVector<struct iovec, tinystl_iov_inline>;
+
+template <typename ContiguousIterator>
+static size_t __make_iovec(ContiguousIterator first, ContiguousIterator last, struct iovec *iov, size_t max, false_type) {
+	if(first == last || max == 0) {
+		return 0;
+	}
+	iov->iov_base = const_cast<void *>(static_cast<const void *>(&*first));
+	iov->iov_len = (last - first) * sizeof(*first);
+	return 1;
+}
+
+// 逐段填写，跳过空段，段数超过max时截断
+template <typename SegmentedIterator>
+static size_t __make_iovec(SegmentedIterator first, SegmentedIterator last, struct iovec *iov, size_t max, true_type) {
+	using traits = segmented_iterator_traits<SegmentedIterator>;
+	auto sf = traits::segment(first);
+	auto sl = traits::segment(last);
+	if(sf == sl) {
+		return __make_iovec(traits::local(first), traits::local(last), iov, max, false_type());
+	}
+	size_t n = __make_iovec(traits::local(first), traits::end(sf), iov, max, false_type());
+	for(++sf;sf != sl && n < max;++sf) {
+		n += __make_iovec(traits::begin(sf), traits::end(sf), iov + n, max - n, false_type());
+	}
+	if(n < max) {
+		n += __make_iovec(traits::begin(sl), traits::local(last), iov + n, max - n, false_type());
+	}
+	return n;
+}
+
+// 将[first, last)的存储写入iov，至多max项，返回使用的项数
+// 所需项数超过max时只描述前max段，即[first, last)的一个前缀，各项长度之和可能小于区间长度，
+// 调用方须以实际传输的字节数为准，drain_to即依赖于此只删除已写出的前缀
+// 迭代器须为分段迭代器，或指向连续内存
+template <typename Iterator>
+size_t make_iovec(Iterator first, Iterator last, struct iovec *iov, size_t max) {
+	return __make_iovec(first, last, iov, max, typename segmented_iterator_traits<Iterator>::is_segmented());
+}
+
+template <typename ContiguousIterator>
+static size_t __iovec_count(ContiguousIterator first, ContiguousIterator last, size_t, false_type) {
+	return first == last ? 0 : 1;
+}
+
+// 计入空段，结果不小于make_iovec实际使用的项数
+template <typename SegmentedIterator>
+static size_t __iovec_count(SegmentedIterator first, SegmentedIterator last, size_t max, true_type) {
+	using traits = segmented_iterator_traits<SegmentedIterator>;
+	size_t n = 1;
+	for(auto sf = traits::segment(first), sl = traits::segment(last);sf != sl && n < max;++sf) {
+		++n;
+	}
+	return n;
+}
+
+// 描述[first, last)至多需要的iovec项数，不超过max
+template <typename Iterator>
+size_t iovec_count(Iterator first, Iterator last, size_t max) {
+	return __iovec_count(first, last, max, typename segmented_iterator_traits<Iterator>::is_segmented());
+}
+
+// 自offset起将容器的内容聚集写入fd，单次writev，返回值与writev相同
+// 段数超过tinystl_iov_max时只写出前tinystl_iov_max段
+template <typename Container>
+ssize_t write_from(int fd, const Container &c, size_t offset = 0) {
+	auto first = c.begin() + offset;
+	iovec_buffer iov(iovec_count(first, c.end(), tinystl_iov_max));
+	size_t n = make_iovec(first, c.end(), iov.begin(), iov.size());
+	if(n == 0) {
+		return 0;
+	}
+	return ::writev(fd, iov.begin(), static_cast<int>(n));
+}
+
+// 写出容器头部的内容并删除已写出的部分，适用于作为发送缓冲区的Deque
+template <typename Container>
+ssize_t drain_to(int fd, Container &c) {
+	static_assert(sizeof(typename Container::value_type) == 1, "element must be a single byte");
+	ssize_t r = write_from(fd, c);
+	if(r > 0) {
+		c.erase(c.begin(), c.begin() + r);
+	}
+	return r;
+}
+
+// 自fd分散读取至多n个字节追加到容器尾部，单次readv，返回值与readv相同
+// 新增的存储不做初始化，读取后按实际读到的字节数截断
+template <typename Container>
+ssize_t read_into(int fd, Container &c, size_t n) {
+	static_assert(sizeof(typename Container::value_type) == 1, "element must be a single byte");
+	size_t si = c.size();
+	c.resize_default_init(si + n);
+	auto first = c.begin() + si;
+	iovec_buffer iov(iovec_count(first, c.end(), tinystl_iov_max));
+	size_t cnt = make_iovec(first, c.end(), iov.begin(), iov.size());
+	ssize_t r = cnt == 0 ? 0 : ::readv(fd, iov.begin(), static_cast<int>(cnt));
+	c.resize_default_init(si + (r > 0 ? static_cast<size_t>(r) : 0));
+	return r;
+}
+
+} // namespace stl
+
+#endif // _SCATTER_IO_HPP__
@@ -33,6 +33,12 @@ public:
 	explicit Set(const Compare &comp = Compare()) :m_rb_tree_(comp) {
 	}
 
+	explicit Set(const ALLOC &allocator) :m_rb_tree_(Compare(), allocator) {
+	}
+
+	Set(const Compare &comp, const ALLOC &allocator) :m_rb_tree_(comp, allocator) {
+	}
+
 	Set(const Set &other) :m_rb_tree_(other.m_rb_tree_) {
 	}
 
@@ -97,6 +103,7 @@ public:
 
 	template <typename InputIterator>
 	void insert(InputIterator first, InputIterator last) {
+		m_rb_tree_.reserve_nodes(first, last);
 		for(;first != last;++first) {
 			m_rb_tree_.insert_unique(*first);
 		}
@@ -167,6 +174,12 @@ public:
 	explicit MultiSet(const Compare &comp = Compare()) :m_rb_tree_(comp) {
 	}
 
+	explicit MultiSet(const ALLOC &allocator) :m_rb_tree_(Compare(), allocator) {
+	}
+
+	MultiSet(const Compare &comp, const ALLOC &allocator) :m_rb_tree_(comp, allocator) {
+	}
+
 	MultiSet(const MultiSet &other) :m_rb_tree_(other.m_rb_tree_) {
 	}
 
@@ -231,6 +244,7 @@ public:
 
 	template <typename InputIterator>
 	void insert(InputIterator first, InputIterator last) {
+		m_rb_tree_.reserve_nodes(first, last);
 		for(;first != last;++first) {
 			m_rb_tree_.insert_equal(*first);
 		}
@@ -279,6 +293,15 @@ public:
 	}
 }; // class MultiSet
 
+// 仅持有一棵红黑树，与红黑树同样可按位搬移
+template <typename T, typename Compare, typename ALLOC>
+struct is_trivially_relocatable<Set<T, Compare, ALLOC>> :members_trivially_relocatable<Compare, ALLOC> {
+}; // struct is_trivially_relocatable<Set<T, Compare, ALLOC>>
+
+template <typename T, typename Compare, typename ALLOC>
+struct is_trivially_relocatable<MultiSet<T, Compare, ALLOC>> :members_trivially_relocatable<Compare, ALLOC> {
+}; // struct is_trivially_relocatable<MultiSet<T, Compare, ALLOC>>
+
 } // namespace stl
 
 #endif // _SET_HPP__
\ No newline at end of file
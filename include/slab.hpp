@@ -0,0 +1,312 @@
+#ifndef _SLAB_HPP__
+#define _SLAB_HPP__
+
+/**
+ * 定长对象的slab配置器
+ * 同一大小与对齐的对象从大页中连续切分，回收后挂入侵入式空闲链表，
+ * 每个线程持有独立的slab，线程退出后slab连同其内存页交由新线程接管
+*/
+
+#include <new>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "allocator.hpp"
+
+namespace stl {
+
+template <size_t Size, size_t Align>
+class Slab {
+public:
+	using size_type = size_t;
+
+	// 对象占用的字节数，需容纳空闲链表指针
+	static constexpr size_type object_size =
+		((Size < sizeof(void *) ? sizeof(void *) : Size) + Align - 1) / Align * Align;
+	// 每次向系统申请的内存页大小
+	static constexpr size_type page_size = 64 * 1024;
+private:
+	struct FreeObject {
+		FreeObject *m_next_;
+	}; // struct FreeObject
+
+	// 内存页头部，按申请顺序组成单链表
+	struct Page {
+		Page *m_next_;
+	}; // struct Page
+
+	static constexpr size_type page_align = Align < sizeof(void *) ? sizeof(void *) : Align;
+	static constexpr size_type header_size = (sizeof(Page) + Align - 1) / Align * Align;
+
+	static_assert((Align & (Align - 1)) == 0, "alignment must be a power of two");
+	static_assert(header_size + object_size <= page_size, "object too large for slab page");
+
+	FreeObject *m_free_list_;
+	size_type m_free_count_;
+	Page *m_page_list_;
+	// 当前页中尚未切分的区域
+	char *m_cursor_;
+	char *m_end_;
+	// 空闲slab链
+	Slab *m_next_idle_;
+
+	void grow() {
+		void *mem = nullptr;
+		if(::posix_memalign(&mem, page_align, page_size) != 0) {
+			throw std::bad_alloc();
+		}
+		Page *page = static_cast<Page *>(mem);
+		page->m_next_ = m_page_list_;
+		m_page_list_ = page;
+		m_cursor_ = static_cast<char *>(mem) + header_size;
+		m_end_ = static_cast<char *>(mem) + page_size;
+	}
+
+	// 从当前页切分一个对象
+	inline void *carve() {
+		if(static_cast<size_type>(m_end_ - m_cursor_) < object_size) {
+			grow();
+		}
+		void *p = m_cursor_;
+		m_cursor_ += object_size;
+		return p;
+	}
+
+	Slab() :
+		m_free_list_(nullptr),
+		m_free_count_(0),
+		m_page_list_(nullptr),
+		m_cursor_(nullptr),
+		m_end_(nullptr),
+		m_next_idle_(nullptr) {
+	}
+
+	Slab(const Slab &) = delete;
+	Slab &operator=(const Slab &) = delete;
+
+	// 空闲slab链的互斥锁
+	static inline std::mutex &idle_mutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	// 空闲slab链，线程退出后其slab挂入，供新线程接管
+	static inline Slab *&idle_list() {
+		static Slab *list = nullptr;
+		return list;
+	}
+
+	// 获取一个slab，优先接管已退出线程留下的slab
+	static Slab *acquire() {
+		{
+			std::lock_guard<std::mutex> lock(idle_mutex());
+			Slab *&list = idle_list();
+			if(list != nullptr) {
+				Slab *slab = list;
+				list = slab->m_next_idle_;
+				slab->m_next_idle_ = nullptr;
+				return slab;
+			}
+		}
+		return new Slab();
+	}
+
+	// 归还slab，slab与其内存页在进程结束前不会释放
+	static void release(Slab *slab) {
+		std::lock_guard<std::mutex> lock(idle_mutex());
+		Slab *&list = idle_list();
+		slab->m_next_idle_ = list;
+		list = slab;
+	}
+
+	// 当前线程是否已退出
+	static inline bool &thread_exited() {
+		static thread_local bool exited = false;
+		return exited;
+	}
+
+	// 线程退出时归还所绑定的slab
+	struct ThreadGuard {
+		Slab *m_slab_;
+
+		~ThreadGuard() {
+			release(m_slab_);
+			thread_exited() = true;
+		}
+	}; // struct ThreadGuard
+
+	// 当前线程绑定的slab，线程退出阶段返回nullptr
+	static inline Slab *local() {
+		if(thread_exited()) {
+			return nullptr;
+		}
+		static thread_local ThreadGuard guard{ acquire() };
+		return guard.m_slab_;
+	}
+public:
+	// 分配一个对象
+	static inline void *allocate() {
+		Slab *slab = local();
+		if(slab == nullptr) {
+			// 线程退出阶段的分配临时借用一个slab
+			slab = acquire();
+			void *res = slab->pop();
+			release(slab);
+			return res;
+		}
+		return slab->pop();
+	}
+
+	// 回收一个对象
+	static inline void deallocate(void *p) {
+		Slab *slab = local();
+		if(slab == nullptr) {
+			slab = acquire();
+			slab->push(p);
+			release(slab);
+			return;
+		}
+		slab->push(p);
+	}
+
+	// 预先备好n个对象，其后的分配依次取用地址连续的对象
+	static void reserve(size_type n) {
+		Slab *slab = local();
+		if(slab == nullptr || slab->m_free_count_ >= n) {
+			return;
+		}
+		n -= slab->m_free_count_;
+		// 连续切分后逆序挂入空闲链表，使取用顺序与地址顺序一致
+		FreeObject *head = nullptr;
+		FreeObject *tail = nullptr;
+		for(size_type i = 0;i < n;++i) {
+			FreeObject *obj = static_cast<FreeObject *>(slab->carve());
+			obj->m_next_ = nullptr;
+			if(tail == nullptr) {
+				head = obj;
+			} else {
+				tail->m_next_ = obj;
+			}
+			tail = obj;
+		}
+		tail->m_next_ = slab->m_free_list_;
+		slab->m_free_list_ = head;
+		slab->m_free_count_ += n;
+	}
+private:
+	inline void *pop() {
+		FreeObject *obj = m_free_list_;
+		if(obj == nullptr) {
+			return carve();
+		}
+		m_free_list_ = obj->m_next_;
+		--m_free_count_;
+		return obj;
+	}
+
+	inline void push(void *p) {
+		FreeObject *obj = static_cast<FreeObject *>(p);
+		obj->m_next_ = m_free_list_;
+		m_free_list_ = obj;
+		++m_free_count_;
+	}
+}; // class Slab
+
+template <size_t Size, size_t Align>
+constexpr typename Slab<Size, Align>::size_type Slab<Size, Align>::object_size;
+
+// 单个对象取自slab，多个对象的数组使用::operator new
+template <typename T>
+class SlabAllocator {
+public:
+	// 定义类型
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = size_t;
+	using difference_type = ::ptrdiff_t;
+
+	using slab_type = Slab<sizeof(T), alignof(T)>;
+
+	// 嵌套类型
+	template <typename U>
+	struct rebind {
+		using other = SlabAllocator<U>;
+	}; // struct rebind
+public:
+	// 构造函数
+	SlabAllocator() = default;
+	SlabAllocator(const SlabAllocator &) = default;
+	~SlabAllocator() = default;
+
+	template<typename U>
+	SlabAllocator(const SlabAllocator<U> &u) {
+	}
+
+	// 获取对象地址
+	inline pointer address(reference x) const {
+		return static_cast<pointer>(&x);
+	}
+
+	inline const_pointer address(const_reference x) const {
+		return static_cast<const_pointer>(&x);
+	}
+
+	// 分配内存空间
+	pointer allocate(size_type n, const void * = nullptr) {
+		if(n == 1) {
+			return static_cast<pointer>(slab_type::allocate());
+		}
+		return static_cast<pointer>(::operator new(n * sizeof(value_type)));
+	}
+
+	// 释放内存空间
+	void deallocate(pointer p, size_type n) {
+		if(n == 1) {
+			slab_type::deallocate(p);
+			return;
+		}
+		::operator delete(p);
+	}
+
+	// 提示即将逐个分配n个对象，预先从slab中批量切分
+	void reserve(size_type n) {
+		slab_type::reserve(n);
+	}
+
+	// 对象最大数量
+	size_type max_size() const {
+		return static_cast<size_type>(UINT32_MAX / sizeof(value_type));
+	}
+
+	// 使用对应指针进行构造
+	template <typename ... Args>
+	void construct(pointer p, Args&& ... x) {
+		new(p) value_type(std::forward<Args>(x)...);
+	}
+
+	// 使用对应指针进行析构
+	void destory(pointer p) {
+		p->~value_type();
+	}
+}; // class SlabAllocator
+
+template <typename T, typename U>
+inline bool operator==(const SlabAllocator<T> &, const SlabAllocator<U> &) {
+	return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const SlabAllocator<T> &, const SlabAllocator<U> &) {
+	return false;
+}
+
+} // namespace stl
+
+#endif // _SLAB_HPP__
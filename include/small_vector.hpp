@@ -0,0 +1,485 @@
+#ifndef _SMALL_VECTOR_HPP__
+#define _SMALL_VECTOR_HPP__
+
+/**
+ * 带内联存储的向量
+ * 前N个元素存放于对象内部，超出后才经由配置器分配堆内存，接口与Vector一致
+*/
+
+#include "allocator.hpp"
+#include "iterator.hpp"
+#include "uninitialized.hpp"
+#include "relocate.hpp"
+#include "reverse_iterator.hpp"
+#include "type_traits.hpp"
+
+namespace stl {
+
+template <typename T, size_t N, typename ALLOCATOR = Allocator<T>>
+class SmallVector {
+public:
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	using iterator = pointer;
+	using const_iterator = const_pointer;
+	using reverse_iterator = ReverseIterator<iterator>;
+	using const_reverse_iterator = const ReverseIterator<iterator>;
+
+	// 内联存储可容纳的元素数量
+	static constexpr size_type inline_capacity = N;
+private:
+	static_assert(N > 0, "inline capacity must be positive");
+
+	ALLOCATOR m_allocator_;
+
+	iterator m_start_;
+	iterator m_last_;
+	iterator m_end_of_storage_;
+
+	// 内联存储，元素在其中原地构造
+	alignas(T) unsigned char m_buffer_[N * sizeof(T)];
+
+	inline pointer inline_data() {
+		return reinterpret_cast<pointer>(m_buffer_);
+	}
+
+	inline const_pointer inline_data() const {
+		return reinterpret_cast<const_pointer>(m_buffer_);
+	}
+
+	// 重置为空的内联存储
+	void reset_inline() {
+		m_start_ = inline_data();
+		m_last_ = m_start_;
+		m_end_of_storage_ = m_start_ + N;
+	}
+
+	// 释放堆内存，内联存储无需释放
+	void deallocate_storage() {
+		if(!is_inline()) {
+			m_allocator_.deallocate(m_start_, m_end_of_storage_ - m_start_);
+		}
+	}
+
+	// 获取应分配内存大小，容量至少为N，由此倍增
+	size_type new_memory(size_type cap) {
+		size_type ncap = capacity();
+		while(ncap < cap) {
+			ncap <<= 1;
+		}
+		return ncap;
+	}
+
+	// 分配至少容纳n个对象的内存，n更新为实际可容纳的数量
+	pointer allocate_at_least(size_type &n) {
+		AllocationResult<pointer> res = allocator_traits<ALLOCATOR>::allocate_at_least(m_allocator_, n);
+		n = res.count;
+		return res.ptr;
+	}
+
+	// 将原有元素搬移至堆上的新内存p，pos之后的元素后移gap个位置，
+	// 新元素须已由调用者构造，搬移抛出异常时释放p且原有元素保持不变
+	void relocate_storage(pointer p, size_type ncap, pointer pos, size_type gap) {
+		size_type si = size();
+		try {
+			relocate_range(m_start_, pos, m_last_, p, gap, m_allocator_);
+		} catch(...) {
+			m_allocator_.deallocate(p, ncap);
+			throw;
+		}
+		deallocate_storage();
+		m_start_ = p;
+		m_last_ = p + si + gap;
+		m_end_of_storage_ = p + ncap;
+	}
+
+	// 接管v的元素，堆内存直接接管，内联元素逐个移动，调用前须为空的内联存储
+	void steal(SmallVector &v) {
+		if(v.is_inline()) {
+			uninitialized_move(v.m_start_, v.m_last_, m_start_, m_allocator_);
+			m_last_ = m_start_ + v.size();
+			initialized_destory(v.m_start_, v.m_last_, v.m_allocator_);
+		} else {
+			m_start_ = v.m_start_;
+			m_last_ = v.m_last_;
+			m_end_of_storage_ = v.m_end_of_storage_;
+		}
+		v.reset_inline();
+	}
+public:
+	SmallVector() {
+		reset_inline();
+	}
+
+	explicit SmallVector(const ALLOCATOR &allocator) :
+		m_allocator_(allocator) {
+		reset_inline();
+	}
+
+	explicit SmallVector(size_type n) {
+		reset_inline();
+		resize(n);
+	}
+
+	explicit SmallVector(size_type n, const T &x) {
+		reset_inline();
+		resize(n, x);
+	}
+
+	template <typename InputIterator>
+	explicit SmallVector(InputIterator first, InputIterator last) {
+		reset_inline();
+		insert(m_last_, first, last);
+	}
+
+	SmallVector(const SmallVector &v) :
+		m_allocator_(v.m_allocator_) {
+		reset_inline();
+		insert(m_last_, v.m_start_, v.m_last_);
+	}
+
+	SmallVector(SmallVector &&v) noexcept(std::is_nothrow_move_constructible<T>::value) :
+		m_allocator_(v.m_allocator_) {
+		reset_inline();
+		steal(v);
+	}
+
+	~SmallVector() {
+		clear();
+	}
+
+	SmallVector &operator=(const SmallVector &v) {
+		if(this != &v) {
+			clear();
+			insert(m_last_, v.m_start_, v.m_last_);
+		}
+		return *this;
+	}
+
+	SmallVector &operator=(SmallVector &&v) {
+		if(this != &v) {
+			clear();
+			m_allocator_ = v.m_allocator_;
+			steal(v);
+		}
+		return *this;
+	}
+
+	// 双方均位于堆上时仅交换指针，否则经由移动交换元素
+	void swap(SmallVector &v) {
+		if(this == &v) {
+			return;
+		}
+		if(!is_inline() && !v.is_inline()) {
+			std::swap(m_allocator_, v.m_allocator_);
+			std::swap(m_start_, v.m_start_);
+			std::swap(m_last_, v.m_last_);
+			std::swap(m_end_of_storage_, v.m_end_of_storage_);
+			return;
+		}
+		SmallVector tmp(std::move(v));
+		v = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	//比较操作相关
+	bool operator==(const SmallVector &v) const {
+		if(v.size() != size()) {
+			return false;
+		}
+		auto si = v.size();
+		for(size_type i = 0;i < si;++i) {
+			if(v[i] != at(i)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const SmallVector &v) const {
+		return !operator==(v);
+	}
+
+	// 迭代器相关
+	inline iterator begin() {
+		return m_start_;
+	}
+
+	inline iterator end() {
+		return m_last_;
+	}
+
+	inline const_iterator begin() const {
+		return m_start_;
+	}
+
+	inline const_iterator end() const {
+		return m_last_;
+	}
+
+	inline reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	inline reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	inline const_reverse_iterator rbegin() const {
+		return reverse_iterator(end());
+	}
+
+	inline const_reverse_iterator rend() const {
+		return reverse_iterator(begin());
+	}
+
+	// 容量相关
+	inline size_type size() const {
+		return m_last_ - m_start_;
+	}
+
+	inline size_type capacity() const {
+		return m_end_of_storage_ - m_start_;
+	}
+
+	inline bool empty() const {
+		return m_last_ == m_start_;
+	}
+
+	// 元素是否位于内联存储中
+	inline bool is_inline() const {
+		return m_start_ == inline_data();
+	}
+
+	// 析构全部元素并释放堆内存，回到内联存储
+	inline void clear() {
+		initialized_destory(m_start_, m_last_, m_allocator_);
+		deallocate_storage();
+		reset_inline();
+	}
+
+	inline void resize(size_type n) {
+		size_type sn = size();
+		if(sn > n) {
+			initialized_destory(m_start_ + n, m_last_, m_allocator_);
+			m_last_ = m_start_ + n;
+		} else if(sn < n) {
+			reserve(new_memory(n));
+			uninitialized_fill(m_last_, m_start_ + n, m_allocator_);
+			m_last_ = m_start_ + n;
+		}
+	}
+
+	inline void resize(size_type n, const T &x) {
+		size_type sn = size();
+		if(sn > n) {
+			initialized_destory(m_start_ + n, m_last_, m_allocator_);
+			m_last_ = m_start_ + n;
+		} else if(sn < n) {
+			insert(m_last_, n - sn, x);
+		}
+	}
+
+	void reserve(size_type n) {
+		if(capacity() >= n) {
+			return;
+		}
+		auto p = allocate_at_least(n);
+		relocate_storage(p, n, m_last_, 0);
+	}
+
+	// 元素数量不超过N时移回内联存储
+	void shrink_to_fit() {
+		if(is_inline() || capacity() == size()) {
+			return;
+		}
+		auto si = size();
+		if(si > N) {
+			auto p = m_allocator_.allocate(si);
+			relocate_storage(p, si, m_last_, 0);
+			return;
+		}
+		pointer old = m_start_;
+		size_type cap = capacity();
+		uninitialized_move_if_noexcept(m_start_, m_last_, inline_data(), m_allocator_);
+		initialized_destory(m_start_, m_last_, m_allocator_);
+		m_allocator_.deallocate(old, cap);
+		reset_inline();
+		m_last_ = m_start_ + si;
+	}
+
+	// 元素相关
+	inline reference operator[](size_type n) {
+		return m_start_[n];
+	}
+
+	inline const_reference operator[](size_type n) const {
+		return m_start_[n];
+	}
+
+	inline reference at(size_type n) {
+		return m_start_[n];
+	}
+
+	inline const_reference at(size_type n) const {
+		return m_start_[n];
+	}
+
+	inline reference front() {
+		return *begin();
+	}
+
+	inline const_reference front() const {
+		return *begin();
+	}
+
+	inline reference back() {
+		return *(end() - 1);
+	}
+
+	inline const_reference back() const {
+		return *(end() - 1);
+	}
+
+	inline pointer data() {
+		return m_start_;
+	}
+
+	inline const_pointer data() const {
+		return m_start_;
+	}
+
+	// 增删操作
+	iterator insert(iterator pos, const value_type &elem) {
+		return insert(pos, (size_type)1, elem);
+	}
+
+	iterator insert(iterator pos, size_type n, const value_type &elem) {
+		auto need_cap = size() + n;
+		if(need_cap > capacity()) {
+			auto ncap = new_memory(need_cap);
+			auto p = allocate_at_least(ncap);
+			auto dis = stl::distance(m_start_, pos);
+			// 先构造新元素，elem可能引用容器内的元素
+			try {
+				uninitialized_fill_n(elem, p + dis, n, m_allocator_);
+			} catch(...) {
+				m_allocator_.deallocate(p, ncap);
+				throw;
+			}
+			relocate_storage(p, ncap, pos, n);
+			return m_start_ + dis;
+		}
+		inplace_insert_fill(pos, m_last_, n, elem, m_allocator_);
+		m_last_ += n;
+		return pos;
+	}
+
+	iterator insert(iterator pos, value_type &&elem) {
+		if(m_last_ >= m_end_of_storage_) {
+			auto ncap = new_memory(capacity() + 1);
+			auto p = allocate_at_least(ncap);
+			auto dis = stl::distance(m_start_, pos);
+			try {
+				m_allocator_.construct(p + dis, std::move(elem));
+			} catch(...) {
+				m_allocator_.deallocate(p, ncap);
+				throw;
+			}
+			relocate_storage(p, ncap, pos, 1);
+			return m_start_ + dis;
+		}
+		inplace_insert_move(pos, m_last_, std::move(elem), m_allocator_);
+		++m_last_;
+		return pos;
+	}
+
+	template <typename I>
+	iterator insert(iterator pos, I first, I last) {
+		size_type n = stl::distance(first, last);
+		auto need_cap = size() + n;
+		if(need_cap > capacity()) {
+			auto ncap = new_memory(need_cap);
+			auto p = allocate_at_least(ncap);
+			auto dis = stl::distance(m_start_, pos);
+			try {
+				uninitialized_copy(first, last, p + dis, m_allocator_);
+			} catch(...) {
+				m_allocator_.deallocate(p, ncap);
+				throw;
+			}
+			relocate_storage(p, ncap, pos, n);
+			return m_start_ + dis;
+		}
+		inplace_insert_range(pos, m_last_, first, last, n, m_allocator_);
+		m_last_ += n;
+		return pos;
+	}
+
+	void push_back(const value_type &elem) {
+		emplace_back(elem);
+	}
+
+	void push_back(value_type &&elem) {
+		emplace_back(std::move(elem));
+	}
+
+	template <typename ... Args>
+	void emplace_back(Args&& ... args) {
+		if(m_last_ >= m_end_of_storage_) {
+			// 新元素先于原有元素构造，参数可能引用容器内的元素
+			auto si = size();
+			auto ncap = new_memory(si + 1);
+			auto p = allocate_at_least(ncap);
+			try {
+				m_allocator_.construct(p + si, std::forward<Args>(args)...);
+			} catch(...) {
+				m_allocator_.deallocate(p, ncap);
+				throw;
+			}
+			relocate_storage(p, ncap, m_last_, 1);
+			return;
+		}
+
+		m_allocator_.construct(m_last_, std::forward<Args>(args)...);
+		++m_last_;
+	}
+
+	iterator erase(iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase(iterator first, iterator last) {
+		auto n = stl::distance(first, last);
+		inplace_erase(first, last, m_last_, m_allocator_);
+		m_last_ -= n;
+		return first;
+	}
+
+	void pop_back() {
+		erase(m_last_ - 1);
+	}
+
+	// 分配器相关
+	inline ALLOCATOR get_allocator() {
+		return m_allocator_;
+	}
+}; // class SmallVector
+
+template <typename T, size_t N, typename ALLOCATOR>
+constexpr typename SmallVector<T, N, ALLOCATOR>::size_type SmallVector<T, N, ALLOCATOR>::inline_capacity;
+
+template <typename T, size_t N, typename ALLOCATOR>
+void swap(SmallVector<T, N, ALLOCATOR> &v, SmallVector<T, N, ALLOCATOR> &vv) {
+	v.swap(vv);
+}
+
+} // namespace stl
+
+#endif // _SMALL_VECTOR_HPP__
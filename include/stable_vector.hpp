@@ -0,0 +1,579 @@
+#ifndef _STABLE_VECTOR_HPP__
+#define _STABLE_VECTOR_HPP__
+
+/**
+ * 分段稳定向量
+ * 元素存放于定长的块中，块由索引表管理，扩容时仅追加新块，原有元素从不搬移，
+ * 因此push_back后元素地址保持不变；块长为2的幂，下标经移位与掩码定位
+ * 索引表由堆上的控制块管理，迭代器经由控制块访问元素，索引表扩展后依然有效；
+ * 控制块在构造时创建，clear后保留，因此空容器取得的迭代器在插入元素后同样有效；
+ * 交换与移动只转移控制块，迭代器随元素一同归属另一容器，被移动的容器在下次分配时另建控制块
+*/
+
+#include <utility>
+
+#include "allocator.hpp"
+#include "iterator.hpp"
+#include "uninitialized.hpp"
+#include "reverse_iterator.hpp"
+#include "type_traits.hpp"
+
+namespace stl {
+
+// 块长，BlockSize为0时取不超过4096字节的最大的2的幂个元素
+inline constexpr size_t tinystl_stable_block_size(size_t n, size_t st) {
+	return n != 0 ? n : tinystl_floor_pow2(4096 / st);
+}
+
+// 索引表的控制块，随容器构造而创建，在容器间转移而不复制
+template <typename T>
+struct StableVectorControl {
+	T **m_map;
+	// 索引表可容纳的块数
+	size_t m_map_size;
+	// 已分配的块数
+	size_t m_block_number;
+}; // struct StableVectorControl
+
+template <typename T, size_t BlockSize, bool Const>
+class StableVectorIterator {
+public:
+	using iterator_category = random_access_iterator_tag;
+	using value_type = T;
+	using difference_type = ::ptrdiff_t;
+	using size_type = size_t;
+	using pointer = typename IfThenElse<Const, const T *, T *>::result;
+	using reference = typename IfThenElse<Const, const T &, T &>::result;
+
+	using control_pointer = const StableVectorControl<T> *;
+	using self = StableVectorIterator<T, BlockSize, Const>;
+
+	static constexpr size_type block_size = tinystl_stable_block_size(BlockSize, sizeof(T));
+	static constexpr size_type block_shift = tinystl_log2(block_size);
+private:
+	control_pointer m_control_;
+	size_type m_index_;
+public:
+	explicit StableVectorIterator(control_pointer control = nullptr, size_type index = 0) :
+		m_control_(control), m_index_(index) {
+	}
+
+	// 可转换为常量迭代器
+	inline operator StableVectorIterator<T, BlockSize, true>() const {
+		return StableVectorIterator<T, BlockSize, true>(m_control_, m_index_);
+	}
+
+	inline size_type index() const {
+		return m_index_;
+	}
+
+	inline reference operator*() const {
+		return m_control_->m_map[m_index_ >> block_shift][m_index_ & (block_size - 1)];
+	}
+
+	inline pointer operator->() const {
+		return &operator*();
+	}
+
+	inline reference operator[](difference_type n) const {
+		return *(*this + n);
+	}
+
+	inline difference_type operator-(const self &s) const {
+		return static_cast<difference_type>(m_index_) - static_cast<difference_type>(s.m_index_);
+	}
+
+	inline bool operator==(const self &s) const {
+		return m_index_ == s.m_index_;
+	}
+
+	inline bool operator!=(const self &s) const {
+		return m_index_ != s.m_index_;
+	}
+
+	inline bool operator<(const self &s) const {
+		return m_index_ < s.m_index_;
+	}
+
+	inline bool operator>(const self &s) const {
+		return m_index_ > s.m_index_;
+	}
+
+	inline bool operator<=(const self &s) const {
+		return m_index_ <= s.m_index_;
+	}
+
+	inline bool operator>=(const self &s) const {
+		return m_index_ >= s.m_index_;
+	}
+
+	inline self &operator+=(difference_type n) {
+		m_index_ += n;
+		return *this;
+	}
+
+	inline self &operator-=(difference_type n) {
+		m_index_ -= n;
+		return *this;
+	}
+
+	inline self operator+(difference_type n) const {
+		return self(m_control_, m_index_ + n);
+	}
+
+	inline self operator-(difference_type n) const {
+		return self(m_control_, m_index_ - n);
+	}
+
+	inline self &operator++() {
+		++m_index_;
+		return *this;
+	}
+
+	inline self operator++(int) {
+		self s = *this;
+		++m_index_;
+		return s;
+	}
+
+	inline self &operator--() {
+		--m_index_;
+		return *this;
+	}
+
+	inline self operator--(int) {
+		self s = *this;
+		--m_index_;
+		return s;
+	}
+}; // class StableVectorIterator
+
+template <typename T, size_t BlockSize, bool Const>
+constexpr typename StableVectorIterator<T, BlockSize, Const>::size_type
+	StableVectorIterator<T, BlockSize, Const>::block_size;
+
+template <typename T, size_t BlockSize, bool Const>
+constexpr typename StableVectorIterator<T, BlockSize, Const>::size_type
+	StableVectorIterator<T, BlockSize, Const>::block_shift;
+
+template <typename T, size_t BlockSize = 0, typename ALLOC = Allocator<T>>
+class StableVector {
+public:
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	using iterator = StableVectorIterator<T, BlockSize, false>;
+	using const_iterator = StableVectorIterator<T, BlockSize, true>;
+	using reverse_iterator = ReverseIterator<iterator>;
+	using const_reverse_iterator = ReverseIterator<const_iterator>;
+
+	using map_type = pointer;
+	using map_pointer = map_type *;
+	using control_type = StableVectorControl<T>;
+	using control_pointer = control_type *;
+
+	static constexpr size_type block_size = iterator::block_size;
+private:
+	static_assert((block_size & (block_size - 1)) == 0, "block size must be a power of 2");
+
+	static constexpr size_type block_shift = iterator::block_shift;
+
+	ALLOC m_block_allocator_;
+	typename ALLOC::template rebind<map_type>::other m_map_allocator_;
+	typename ALLOC::template rebind<control_type>::other m_control_allocator_;
+
+	// 仅被移动后为空
+	control_pointer m_control_;
+	size_type m_size_;
+
+	inline pointer address(size_type n) const {
+		return m_control_->m_map[n >> block_shift] + (n & (block_size - 1));
+	}
+
+	// 已分配的块数
+	inline size_type block_count() const {
+		return m_control_ == nullptr ? 0 : m_control_->m_block_number;
+	}
+
+	// 创建不含索引表的控制块
+	void create_control() {
+		m_control_ = m_control_allocator_.allocate(1);
+		m_control_->m_map = nullptr;
+		m_control_->m_map_size = 0;
+		m_control_->m_block_number = 0;
+	}
+
+	// 索引表至少容纳n个块，仅复制块指针，控制块不变
+	void reserve_map(size_type n) {
+		if(m_control_ == nullptr) {
+			if(n == 0) {
+				return;
+			}
+			create_control();
+		}
+		control_pointer c = m_control_;
+		if(n <= c->m_map_size) {
+			return;
+		}
+		size_type nsize = c->m_map_size * 2 > n ? c->m_map_size * 2 : n;
+		map_pointer p = m_map_allocator_.allocate(nsize);
+		for(size_type i = 0;i < c->m_block_number;++i) {
+			p[i] = c->m_map[i];
+		}
+		if(c->m_map != nullptr) {
+			m_map_allocator_.deallocate(c->m_map, c->m_map_size);
+		}
+		c->m_map = p;
+		c->m_map_size = nsize;
+	}
+
+	// 追加块至共n个块
+	void reserve_blocks(size_type n) {
+		reserve_map(n);
+		for(;block_count() < n;++m_control_->m_block_number) {
+			m_control_->m_map[m_control_->m_block_number] = m_block_allocator_.allocate(block_size);
+		}
+	}
+
+	// 释放第n个块及其后的空块
+	void release_blocks(size_type n) {
+		if(m_control_ == nullptr) {
+			return;
+		}
+		control_pointer c = m_control_;
+		for(size_type i = n;i < c->m_block_number;++i) {
+			m_block_allocator_.deallocate(c->m_map[i], block_size);
+		}
+		c->m_block_number = n < c->m_block_number ? n : c->m_block_number;
+	}
+
+	// 容纳n个元素所需的块数
+	static inline size_type block_number(size_type n) {
+		return (n + block_size - 1) >> block_shift;
+	}
+
+	// 逐块析构[first, last)中的元素
+	void destory_range(size_type first, size_type last) {
+		while(first != last) {
+			size_type end = (first | (block_size - 1)) + 1;
+			end = end < last ? end : last;
+			initialized_destory(address(first), address(first) + (end - first), m_block_allocator_);
+			first = end;
+		}
+	}
+public:
+	StableVector() :
+		m_control_(nullptr),
+		m_size_(0) {
+		create_control();
+	}
+
+	explicit StableVector(const ALLOC &allocator) :
+		m_block_allocator_(allocator),
+		m_map_allocator_(allocator),
+		m_control_allocator_(allocator),
+		m_control_(nullptr),
+		m_size_(0) {
+		create_control();
+	}
+
+	explicit StableVector(size_type n) :StableVector() {
+		resize(n);
+	}
+
+	explicit StableVector(size_type n, const T &x) :StableVector() {
+		resize(n, x);
+	}
+
+	template <typename InputIterator>
+	explicit StableVector(InputIterator first, InputIterator last) :StableVector() {
+		for(;first != last;++first) {
+			emplace_back(*first);
+		}
+	}
+
+	StableVector(const StableVector &v) :StableVector(v.m_block_allocator_) {
+		reserve(v.m_size_);
+		for(size_type i = 0;i < v.m_size_;++i) {
+			emplace_back(v[i]);
+		}
+	}
+
+	// 接管控制块，v的迭代器随之归属新容器
+	StableVector(StableVector &&v) noexcept :
+		m_block_allocator_(v.m_block_allocator_),
+		m_map_allocator_(v.m_map_allocator_),
+		m_control_allocator_(v.m_control_allocator_),
+		m_control_(v.m_control_),
+		m_size_(v.m_size_) {
+		v.m_control_ = nullptr;
+		v.m_size_ = 0;
+	}
+
+	~StableVector() {
+		clear();
+		if(m_control_ != nullptr) {
+			m_control_allocator_.deallocate(m_control_, 1);
+		}
+	}
+
+	StableVector &operator=(const StableVector &v) {
+		if(this != &v) {
+			StableVector tmp(v);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	StableVector &operator=(StableVector &&v) {
+		if(this != &v) {
+			clear();
+			swap(v);
+		}
+		return *this;
+	}
+
+	// 交换控制块，双方的迭代器仍指向原来的元素
+	void swap(StableVector &v) {
+		std::swap(m_block_allocator_, v.m_block_allocator_);
+		std::swap(m_map_allocator_, v.m_map_allocator_);
+		std::swap(m_control_allocator_, v.m_control_allocator_);
+		std::swap(m_control_, v.m_control_);
+		std::swap(m_size_, v.m_size_);
+	}
+
+	bool operator==(const StableVector &v) const {
+		if(v.m_size_ != m_size_) {
+			return false;
+		}
+		for(size_type i = 0;i < m_size_;++i) {
+			if(!(v[i] == operator[](i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const StableVector &v) const {
+		return !operator==(v);
+	}
+
+	// 迭代器相关
+	inline iterator begin() {
+		return iterator(m_control_, 0);
+	}
+
+	inline iterator end() {
+		return iterator(m_control_, m_size_);
+	}
+
+	inline const_iterator begin() const {
+		return const_iterator(m_control_, 0);
+	}
+
+	inline const_iterator end() const {
+		return const_iterator(m_control_, m_size_);
+	}
+
+	inline reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	inline reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	inline const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	inline const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// 分段访问，第i段为连续内存[segment_data(i), segment_data(i) + segment_size(i))
+	inline size_type segment_count() const {
+		return block_number(m_size_);
+	}
+
+	inline pointer segment_data(size_type i) {
+		return m_control_->m_map[i];
+	}
+
+	inline const_pointer segment_data(size_type i) const {
+		return m_control_->m_map[i];
+	}
+
+	inline size_type segment_size(size_type i) const {
+		return i + 1 < segment_count() ? block_size : m_size_ - (i << block_shift);
+	}
+
+	// 依次以每段的首尾指针调用f(first, last)
+	template <typename F>
+	F for_each_segment(F f) {
+		size_type n = segment_count();
+		for(size_type i = 0;i < n;++i) {
+			f(m_control_->m_map[i], m_control_->m_map[i] + segment_size(i));
+		}
+		return f;
+	}
+
+	template <typename F>
+	F for_each_segment(F f) const {
+		size_type n = segment_count();
+		for(size_type i = 0;i < n;++i) {
+			f(const_pointer(m_control_->m_map[i]), const_pointer(m_control_->m_map[i]) + segment_size(i));
+		}
+		return f;
+	}
+
+	// 容量相关
+	inline size_type size() const {
+		return m_size_;
+	}
+
+	inline size_type capacity() const {
+		return block_count() << block_shift;
+	}
+
+	inline bool empty() const {
+		return m_size_ == 0;
+	}
+
+	// 析构全部元素并释放全部块与索引表，保留控制块
+	void clear() {
+		destory_range(0, m_size_);
+		m_size_ = 0;
+		if(m_control_ == nullptr) {
+			return;
+		}
+		release_blocks(0);
+		if(m_control_->m_map != nullptr) {
+			m_map_allocator_.deallocate(m_control_->m_map, m_control_->m_map_size);
+		}
+		m_control_->m_map = nullptr;
+		m_control_->m_map_size = 0;
+	}
+
+	void reserve(size_type n) {
+		reserve_blocks(block_number(n));
+	}
+
+	// 释放未使用的块，元素地址不变
+	void shrink_to_fit() {
+		release_blocks(block_number(m_size_));
+	}
+
+	void resize(size_type n) {
+		if(n < m_size_) {
+			destory_range(n, m_size_);
+			m_size_ = n;
+			return;
+		}
+		reserve(n);
+		while(m_size_ < n) {
+			emplace_back();
+		}
+	}
+
+	void resize(size_type n, const T &x) {
+		if(n < m_size_) {
+			destory_range(n, m_size_);
+			m_size_ = n;
+			return;
+		}
+		reserve(n);
+		while(m_size_ < n) {
+			emplace_back(x);
+		}
+	}
+
+	// 元素相关
+	inline reference operator[](size_type n) {
+		return *address(n);
+	}
+
+	inline const_reference operator[](size_type n) const {
+		return *address(n);
+	}
+
+	inline reference at(size_type n) {
+		return *address(n);
+	}
+
+	inline const_reference at(size_type n) const {
+		return *address(n);
+	}
+
+	inline reference front() {
+		return *address(0);
+	}
+
+	inline const_reference front() const {
+		return *address(0);
+	}
+
+	inline reference back() {
+		return *address(m_size_ - 1);
+	}
+
+	inline const_reference back() const {
+		return *address(m_size_ - 1);
+	}
+
+	// 增删操作，仅在尾部进行，其余元素的地址不变
+	inline void push_back(const value_type &elem) {
+		emplace_back(elem);
+	}
+
+	inline void push_back(value_type &&elem) {
+		emplace_back(std::move(elem));
+	}
+
+	// 块已满时追加新块，原有元素不动，参数引用容器内的元素亦无妨
+	template <typename ... Args>
+	inline reference emplace_back(Args&& ... args) {
+		if(m_size_ == capacity()) {
+			reserve_blocks(block_count() + 1);
+		}
+		pointer p = address(m_size_);
+		m_block_allocator_.construct(p, std::forward<Args>(args)...);
+		++m_size_;
+		return *p;
+	}
+
+	void pop_back() {
+		--m_size_;
+		m_block_allocator_.destory(address(m_size_));
+	}
+
+	// 分配器相关
+	inline ALLOC get_allocator() {
+		return m_block_allocator_;
+	}
+}; // class StableVector
+
+template <typename T, size_t BlockSize, typename ALLOC>
+constexpr typename StableVector<T, BlockSize, ALLOC>::size_type StableVector<T, BlockSize, ALLOC>::block_size;
+
+template <typename T, size_t BlockSize, typename ALLOC>
+constexpr typename StableVector<T, BlockSize, ALLOC>::size_type StableVector<T, BlockSize, ALLOC>::block_shift;
+
+// 仅持有配置器与指向控制块的指针，可按位搬移，迭代器引用控制块，搬移后依然有效
+template <typename T, size_t BlockSize, typename ALLOC>
+struct is_trivially_relocatable<StableVector<T, BlockSize, ALLOC>> :members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<StableVector<T, BlockSize, ALLOC>>
+
+template <typename T, size_t BlockSize, typename ALLOC>
+void swap(StableVector<T, BlockSize, ALLOC> &v, StableVector<T, BlockSize, ALLOC> &vv) {
+	v.swap(vv);
+}
+
+} // namespace stl
+
+#endif // _STABLE_VECTOR_HPP__
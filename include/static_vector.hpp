@@ -0,0 +1,393 @@
+#ifndef _STATIC_VECTOR_HPP__
+#define _STATIC_VECTOR_HPP__
+
+/**
+ * 定容向量
+ * 元素全部存放于对象内部，容量固定为N，从不分配内存，接口与Vector一致，
+ * 超出容量的push_back、emplace_back与insert触发断言，try_push_back与try_emplace_back返回false
+*/
+
+#include <new>
+#include <utility>
+#include <cassert>
+
+#include "iterator.hpp"
+#include "uninitialized.hpp"
+#include "relocate.hpp"
+#include "reverse_iterator.hpp"
+#include "type_traits.hpp"
+
+namespace stl {
+
+// 仅在已有内存上构造与析构对象，供uninitialized.hpp中的函数使用
+template <typename T>
+struct InplaceConstructor {
+	using value_type = T;
+	using pointer = T *;
+
+	template <typename ... Args>
+	inline void construct(pointer p, Args&& ... x) {
+		new(p) value_type(std::forward<Args>(x)...);
+	}
+
+	inline void destory(pointer p) {
+		p->~value_type();
+	}
+}; // struct InplaceConstructor
+
+template <typename T, size_t N>
+class StaticVector {
+public:
+	using value_type = T;
+	using pointer = value_type *;
+	using const_pointer = const value_type *;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	using iterator = pointer;
+	using const_iterator = const_pointer;
+	using reverse_iterator = ReverseIterator<iterator>;
+	using const_reverse_iterator = const ReverseIterator<iterator>;
+
+	static constexpr size_type static_capacity = N;
+private:
+	static_assert(N > 0, "capacity must be positive");
+
+	alignas(T) unsigned char m_buffer_[N * sizeof(T)];
+	size_type m_size_;
+
+	// 构造器不含状态，不占用对象空间
+	static inline InplaceConstructor<T> constructor() {
+		return InplaceConstructor<T>();
+	}
+
+	inline pointer storage() {
+		return reinterpret_cast<pointer>(m_buffer_);
+	}
+
+	inline const_pointer storage() const {
+		return reinterpret_cast<const_pointer>(m_buffer_);
+	}
+
+	// 前向迭代器一次留出空位后构造
+	template <typename I>
+	iterator insert(iterator pos, I first, I last, forward_iterator_tag) {
+		size_type n = stl::distance(first, last);
+		assert(m_size_ + n <= N);
+		stl::inplace_insert_range(pos, end(), first, last, n, constructor());
+		m_size_ += n;
+		return pos;
+	}
+
+	template <typename I>
+	iterator insert(iterator pos, I first, I last, input_iterator_tag) {
+		size_type dis = pos - begin();
+		for(;first != last;++first, ++pos) {
+			pos = insert(pos, value_type(*first));
+		}
+		return begin() + dis;
+	}
+public:
+	StaticVector() :m_size_(0) {
+	}
+
+	explicit StaticVector(size_type n) :m_size_(0) {
+		resize(n);
+	}
+
+	explicit StaticVector(size_type n, const T &x) :m_size_(0) {
+		resize(n, x);
+	}
+
+	template <typename InputIterator>
+	explicit StaticVector(InputIterator first, InputIterator last) :m_size_(0) {
+		insert(end(), first, last);
+	}
+
+	StaticVector(const StaticVector &v) :m_size_(0) {
+		stl::uninitialized_copy(v.begin(), v.end(), begin(), constructor());
+		m_size_ = v.m_size_;
+	}
+
+	StaticVector(StaticVector &&v) noexcept(std::is_nothrow_move_constructible<T>::value) :m_size_(0) {
+		stl::uninitialized_move(v.begin(), v.end(), begin(), constructor());
+		m_size_ = v.m_size_;
+	}
+
+	~StaticVector() {
+		clear();
+	}
+
+	StaticVector &operator=(const StaticVector &v) {
+		if(this != &v) {
+			clear();
+			stl::uninitialized_copy(v.begin(), v.end(), begin(), constructor());
+			m_size_ = v.m_size_;
+		}
+		return *this;
+	}
+
+	StaticVector &operator=(StaticVector &&v) {
+		if(this != &v) {
+			clear();
+			stl::uninitialized_move(v.begin(), v.end(), begin(), constructor());
+			m_size_ = v.m_size_;
+		}
+		return *this;
+	}
+
+	// 逐个交换共同部分，较长一方的剩余元素移动至另一方
+	void swap(StaticVector &v) {
+		if(this == &v) {
+			return;
+		}
+		StaticVector &longer = m_size_ < v.m_size_ ? v : *this;
+		StaticVector &shorter = m_size_ < v.m_size_ ? *this : v;
+		size_type common = shorter.m_size_;
+		for(size_type i = 0;i < common;++i) {
+			std::swap(storage()[i], v.storage()[i]);
+		}
+		stl::uninitialized_move(longer.begin() + common, longer.end(), shorter.end(), constructor());
+		stl::initialized_destory(longer.begin() + common, longer.end(), constructor());
+		shorter.m_size_ = longer.m_size_;
+		longer.m_size_ = common;
+	}
+
+	//比较操作相关
+	bool operator==(const StaticVector &v) const {
+		if(v.size() != size()) {
+			return false;
+		}
+		auto si = v.size();
+		for(size_type i = 0;i < si;++i) {
+			if(v[i] != at(i)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const StaticVector &v) const {
+		return !operator==(v);
+	}
+
+	// 迭代器相关
+	inline iterator begin() {
+		return storage();
+	}
+
+	inline iterator end() {
+		return storage() + m_size_;
+	}
+
+	inline const_iterator begin() const {
+		return storage();
+	}
+
+	inline const_iterator end() const {
+		return storage() + m_size_;
+	}
+
+	inline reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	inline reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	inline const_reverse_iterator rbegin() const {
+		return reverse_iterator(end());
+	}
+
+	inline const_reverse_iterator rend() const {
+		return reverse_iterator(begin());
+	}
+
+	// 容量相关
+	inline size_type size() const {
+		return m_size_;
+	}
+
+	inline constexpr size_type capacity() const {
+		return N;
+	}
+
+	inline constexpr size_type max_size() const {
+		return N;
+	}
+
+	inline bool empty() const {
+		return m_size_ == 0;
+	}
+
+	inline bool full() const {
+		return m_size_ == N;
+	}
+
+	inline void clear() {
+		stl::initialized_destory(begin(), end(), constructor());
+		m_size_ = 0;
+	}
+
+	inline void resize(size_type n) {
+		assert(n <= N);
+		if(m_size_ > n) {
+			stl::initialized_destory(begin() + n, end(), constructor());
+		} else {
+			stl::uninitialized_fill(end(), begin() + n, constructor());
+		}
+		m_size_ = n;
+	}
+
+	inline void resize(size_type n, const T &x) {
+		assert(n <= N);
+		if(m_size_ > n) {
+			stl::initialized_destory(begin() + n, end(), constructor());
+		} else {
+			stl::uninitialized_fill(x, end(), begin() + n, constructor());
+		}
+		m_size_ = n;
+	}
+
+	// 容量固定，仅检查n不超过N
+	inline void reserve(size_type n) {
+		assert(n <= N);
+	}
+
+	inline void shrink_to_fit() {
+	}
+
+	// 元素相关
+	inline reference operator[](size_type n) {
+		return storage()[n];
+	}
+
+	inline const_reference operator[](size_type n) const {
+		return storage()[n];
+	}
+
+	inline reference at(size_type n) {
+		return storage()[n];
+	}
+
+	inline const_reference at(size_type n) const {
+		return storage()[n];
+	}
+
+	inline reference front() {
+		return *begin();
+	}
+
+	inline const_reference front() const {
+		return *begin();
+	}
+
+	inline reference back() {
+		return *(end() - 1);
+	}
+
+	inline const_reference back() const {
+		return *(end() - 1);
+	}
+
+	inline pointer data() {
+		return storage();
+	}
+
+	inline const_pointer data() const {
+		return storage();
+	}
+
+	// 增删操作
+	iterator insert(iterator pos, const value_type &elem) {
+		return insert(pos, (size_type)1, elem);
+	}
+
+	iterator insert(iterator pos, size_type n, const value_type &elem) {
+		assert(m_size_ + n <= N);
+		stl::inplace_insert_fill(pos, end(), n, elem, constructor());
+		m_size_ += n;
+		return pos;
+	}
+
+	iterator insert(iterator pos, value_type &&elem) {
+		assert(m_size_ < N);
+		stl::inplace_insert_move(pos, end(), std::move(elem), constructor());
+		++m_size_;
+		return pos;
+	}
+
+	template <typename I>
+	iterator insert(iterator pos, I first, I last) {
+		return insert(pos, first, last, iterator_category(first));
+	}
+
+	inline void push_back(const value_type &elem) {
+		emplace_back(elem);
+	}
+
+	inline void push_back(value_type &&elem) {
+		emplace_back(std::move(elem));
+	}
+
+	template <typename ... Args>
+	inline void emplace_back(Args&& ... args) {
+		assert(m_size_ < N);
+		constructor().construct(end(), std::forward<Args>(args)...);
+		++m_size_;
+	}
+
+	// 已满时返回false且不构造元素
+	inline bool try_push_back(const value_type &elem) {
+		return try_emplace_back(elem);
+	}
+
+	inline bool try_push_back(value_type &&elem) {
+		return try_emplace_back(std::move(elem));
+	}
+
+	template <typename ... Args>
+	inline bool try_emplace_back(Args&& ... args) {
+		if(m_size_ == N) {
+			return false;
+		}
+		constructor().construct(end(), std::forward<Args>(args)...);
+		++m_size_;
+		return true;
+	}
+
+	iterator erase(iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase(iterator first, iterator last) {
+		size_type n = last - first;
+		stl::inplace_erase(first, last, end(), constructor());
+		m_size_ -= n;
+		return first;
+	}
+
+	void pop_back() {
+		erase(end() - 1);
+	}
+}; // class StaticVector
+
+template <typename T, size_t N>
+constexpr typename StaticVector<T, N>::size_type StaticVector<T, N>::static_capacity;
+
+// 元素位于对象内部，元素可按位搬移时StaticVector亦然
+template <typename T, size_t N>
+struct is_trivially_relocatable<StaticVector<T, N>> :members_trivially_relocatable<T> {
+}; // struct is_trivially_relocatable<StaticVector<T, N>>
+
+template <typename T, size_t N>
+void swap(StaticVector<T, N> &v, StaticVector<T, N> &vv) {
+	v.swap(vv);
+}
+
+} // namespace stl
+
+#endif // _STATIC_VECTOR_HPP__
@@ -1,6 +1,8 @@
 #ifndef _TYPE_TRAITS_HPP__
 #define _TYPE_TRAITS_HPP__
 
+#include <type_traits>
+
 #include <stdint.h>
 
 namespace stl {
@@ -21,158 +23,63 @@ struct IfThenElse<false, Ta, Tb> {
 struct true_type {};
 struct false_type {};
 
+// 将编译期布尔值转换为true_type/false_type
+template<bool B>
+using bool_type = typename IfThenElse<B, true_type, false_type>::result;
+
+// 由编译器提供的类型特性推导，用户定义的聚合类型同样适用，亦可为特定类型特化
 template<typename T>
 struct type_traits {
-	using has_trivial_default_constructor = false_type;
-	using has_trivial_copy_constructor = false_type;
-	using has_trivial_assignment_operator = false_type;
-	using has_trivial_destructor = false_type;
-	using is_POD_type = false_type;
+	using has_trivial_default_constructor = bool_type<std::is_trivially_default_constructible<T>::value>;
+	using has_trivial_copy_constructor = bool_type<std::is_trivially_copyable<T>::value &&
+		std::is_trivially_copy_constructible<T>::value>;
+	using has_trivial_assignment_operator = bool_type<std::is_trivially_copyable<T>::value &&
+		std::is_trivially_copy_assignable<T>::value>;
+	using has_trivial_destructor = bool_type<std::is_trivially_destructible<T>::value>;
+	using is_POD_type = bool_type<std::is_trivial<T>::value && std::is_standard_layout<T>::value>;
 }; // struct type_traits<T>
 
-template<>
-struct type_traits<bool> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<bool>
-
-template<>
-struct type_traits<char> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<char>
-
-template<>
-struct type_traits<unsigned char> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<unsigned char>
-
-template<>
-struct type_traits<signed char> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<signed char>
-
-template<>
-struct type_traits<wchar_t> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<wchar_t>
-
-template<>
-struct type_traits<int16_t> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<int16_t>
-
-template<>
-struct type_traits<uint16_t> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<uint16_t>
-
-template<>
-struct type_traits<int32_t> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<int32_t>
-
-template<>
-struct type_traits<uint32_t> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<uint32_t>
-
-template<>
-struct type_traits<int64_t> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<int64_t>
-
-template<>
-struct type_traits<uint64_t> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<uint64_t>
-
-template<>
-struct type_traits<float> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<float>
+// 可按位搬移的类型：搬移到新地址时可直接复制内存，无需逐个移动构造再析构原对象
+// 默认为可平凡复制的类型，持有指针或句柄的自定义类型可特化为true_type
+template<typename T>
+struct is_trivially_relocatable {
+	using type = bool_type<std::is_trivially_copyable<T>::value>;
+}; // struct is_trivially_relocatable<T>
+
+// 各类型均可按位搬移时为true_type，用于仅持有这些成员及堆上指针的类型
+template<typename ... Ts>
+struct members_trivially_relocatable {
+	using type = true_type;
+}; // struct members_trivially_relocatable<>
+
+template<typename T, typename ... Ts>
+struct members_trivially_relocatable<T, Ts...> {
+	using type = typename IfThenElse<std::is_same<typename is_trivially_relocatable<T>::type, true_type>::value,
+		typename members_trivially_relocatable<Ts...>::type, false_type>::result;
+}; // struct members_trivially_relocatable<T, Ts...>
+
+// 将true_type/false_type转换为编译期常量
+template<typename Tag>
+struct tag_value;
 
 template<>
-struct type_traits<double> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<double>
+struct tag_value<true_type> {
+	static constexpr bool value = true;
+}; // struct tag_value<true_type>
 
 template<>
-struct type_traits<long double> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<long double>
+struct tag_value<false_type> {
+	static constexpr bool value = false;
+}; // struct tag_value<false_type>
 
-template<typename T>
-struct type_traits<T *> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<T *>
+// 不超过n的最大的2的幂，n为0时为1
+inline constexpr size_t tinystl_floor_pow2(size_t n, size_t p = 1) {
+	return p * 2 > n ? p : tinystl_floor_pow2(n, p * 2);
+}
 
-template<typename T>
-struct type_traits<const T *> {
-	using has_trivial_default_constructor = true_type;
-	using has_trivial_copy_constructor = true_type;
-	using has_trivial_assignment_operator = true_type;
-	using has_trivial_destructor = true_type;
-	using is_POD_type = true_type;
-}; // struct type_traits<const T *>
+inline constexpr size_t tinystl_log2(size_t n) {
+	return n <= 1 ? 0 : 1 + tinystl_log2(n >> 1);
+}
 
 }
 #endif // _TYPE_TRAITS_HPP__
\ No newline at end of file
@@ -3,6 +3,11 @@
 
 #include "allocator.hpp"
 #include "iterator.hpp"
+#include "type_traits.hpp"
+
+#include <utility>
+
+#include <string.h>
 
 namespace stl {
 
@@ -23,76 +28,331 @@ constexpr typename I::pointer pointer_traits(I p) {
 	return pointer_traits(p.base());
 }
 
-} // namespace
+// 源与目标均为指向同一类型的指针且该类型可平凡复制时，可按字节复制
+template <typename I, typename O>
+struct trivial_copy_traits {
+	using type = false_type;
+}; // struct trivial_copy_traits<I, O>
+
+template <typename T>
+struct trivial_copy_traits<T *, T *> {
+	using type = typename type_traits<T>::has_trivial_copy_constructor;
+}; // struct trivial_copy_traits<T *, T *>
+
+template <typename T>
+struct trivial_copy_traits<const T *, T *> {
+	using type = typename type_traits<T>::has_trivial_copy_constructor;
+}; // struct trivial_copy_traits<const T *, T *>
+
+// 目标为指针且该类型可平凡构造与赋值时，可将值初始化的结果直接赋值
+template <typename I>
+struct trivial_fill_traits {
+	using type = false_type;
+}; // struct trivial_fill_traits<I>
+
+template <typename T>
+struct trivial_fill_traits<T *> {
+	using type = bool_type<tag_value<typename type_traits<T>::has_trivial_default_constructor>::value &&
+		tag_value<typename type_traits<T>::has_trivial_assignment_operator>::value>;
+}; // struct trivial_fill_traits<T *>
+
+// 目标为指针且该类型可平凡复制与赋值时，可直接赋值
+template <typename I>
+struct trivial_fill_value_traits {
+	using type = false_type;
+}; // struct trivial_fill_value_traits<I>
+
+template <typename T>
+struct trivial_fill_value_traits<T *> {
+	using type = bool_type<tag_value<typename type_traits<T>::has_trivial_copy_constructor>::value &&
+		tag_value<typename type_traits<T>::has_trivial_assignment_operator>::value>;
+}; // struct trivial_fill_value_traits<T *>
+
+// 构造过程中抛出异常时析构[first, cur)中已构造的对象
+template <typename ForwardIterator, typename Alloc>
+inline void __rollback(ForwardIterator first, ForwardIterator cur, Alloc &allocator) {
+	for(;first != cur;++first) {
+		allocator.destory(pointer_traits(first));
+	}
+}
 
 template <typename InputIterator, typename ForwardIterator, typename Alloc>
-ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
-	ForwardIterator result, Alloc allocator) {
+inline void __uninitialized_copy(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc &allocator, false_type) {
 	auto p = first;
 	auto q = result;
-	for(;p != last;++p, ++q) {
-		allocator.construct(pointer_traits(q), *p);
+	try {
+		for(;p != last;++p, ++q) {
+			allocator.construct(pointer_traits(q), *p);
+		}
+	} catch(...) {
+		__rollback(result, q, allocator);
+		throw;
 	}
-	return result;
 }
 
 template <typename InputIterator, typename ForwardIterator, typename Alloc>
-ForwardIterator uninitialized_move(InputIterator first, InputIterator last,
-	ForwardIterator result, Alloc allocator) {
+inline void __uninitialized_copy(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc &, true_type) {
+	if(first != last) {
+		::memcpy(static_cast<void *>(result), static_cast<const void *>(first),
+			(last - first) * sizeof(*first));
+	}
+}
+
+template <typename InputIterator, typename ForwardIterator, typename Alloc>
+inline void __uninitialized_move(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc &allocator, false_type) {
 	auto p = first;
 	auto q = result;
-	for(;p != last;++p, ++q) {
-		allocator.construct(pointer_traits(q), std::move(*p));
+	try {
+		for(;p != last;++p, ++q) {
+			allocator.construct(pointer_traits(q), std::move(*p));
+		}
+	} catch(...) {
+		__rollback(result, q, allocator);
+		throw;
+	}
+}
+
+template <typename InputIterator, typename ForwardIterator, typename Alloc>
+inline void __uninitialized_move(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc &, true_type) {
+	if(first != last) {
+		::memcpy(static_cast<void *>(result), static_cast<const void *>(first),
+			(last - first) * sizeof(*first));
+	}
+}
+
+// 可平凡复制的类型，单字节或全零的值直接置位，其余逐个赋值以便编译器向量化
+template <typename T, typename U>
+inline void __fill_trivial(T *first, size_t size, const U &x) {
+	const T value = x;
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&value);
+	bool same = true;
+	for(size_t i = 1;same && i < sizeof(T);++i) {
+		same = bytes[i] == bytes[0];
+	}
+	if(same && (sizeof(T) == 1 || bytes[0] == 0)) {
+		::memset(static_cast<void *>(first), bytes[0], size * sizeof(T));
+		return;
+	}
+	for(size_t i = 0;i < size;++i) {
+		first[i] = value;
+	}
+}
+
+// 移动构造不抛出异常或不可复制时移动，否则复制，以便调用者提供强异常安全保证
+template <typename InputIterator, typename ForwardIterator, typename Alloc>
+inline void __uninitialized_move_if_noexcept(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc &allocator, false_type) {
+	auto p = first;
+	auto q = result;
+	try {
+		for(;p != last;++p, ++q) {
+			allocator.construct(pointer_traits(q), std::move_if_noexcept(*p));
+		}
+	} catch(...) {
+		__rollback(result, q, allocator);
+		throw;
 	}
-	return result;
+}
+
+template <typename InputIterator, typename ForwardIterator, typename Alloc>
+inline void __uninitialized_move_if_noexcept(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc &allocator, true_type) {
+	__uninitialized_move(first, last, result, allocator, true_type());
 }
 
 template <typename InputIterator, typename Alloc>
-void uninitialized_fill(InputIterator first, InputIterator last, Alloc allocator) {
+inline void __uninitialized_fill(InputIterator first, InputIterator last, Alloc &allocator, false_type) {
 	auto p = first;
-	for(;p != last;++p) {
-		allocator.construct(pointer_traits(p));
+	try {
+		for(;p != last;++p) {
+			allocator.construct(pointer_traits(p));
+		}
+	} catch(...) {
+		__rollback(first, p, allocator);
+		throw;
+	}
+}
+
+template <typename InputIterator, typename Alloc>
+inline void __uninitialized_fill(InputIterator first, InputIterator last, Alloc &, true_type) {
+	if(first != last) {
+		__fill_trivial(first, last - first, typename iterator_traits<InputIterator>::value_type());
 	}
 }
 
 template <typename InputIterator, typename Size, typename Alloc>
-void uninitialized_fill_n(InputIterator first, Size size, Alloc allocator) {
+inline void __uninitialized_fill_n(InputIterator first, Size size, Alloc &allocator, false_type) {
 	auto p = first;
-	for(Size s = 0;s < size;++s, ++p) {
-		allocator.construct(pointer_traits(p));
+	try {
+		for(Size s = 0;s < size;++s, ++p) {
+			allocator.construct(pointer_traits(p));
+		}
+	} catch(...) {
+		__rollback(first, p, allocator);
+		throw;
 	}
 }
 
+template <typename InputIterator, typename Size, typename Alloc>
+inline void __uninitialized_fill_n(InputIterator first, Size size, Alloc &, true_type) {
+	if(size > 0) {
+		__fill_trivial(first, size, typename iterator_traits<InputIterator>::value_type());
+	}
+}
+
+template <typename InputIterator, typename Alloc>
+inline void __uninitialized_default_fill(InputIterator first, InputIterator last,
+	Alloc &allocator, false_type) {
+	__uninitialized_fill(first, last, allocator, false_type());
+}
+
+template <typename InputIterator, typename Alloc>
+inline void __uninitialized_default_fill(InputIterator, InputIterator, Alloc &, true_type) {
+}
+
 template <typename InputIterator, typename T, typename Alloc>
-void uninitialized_fill(const T &x, InputIterator first, InputIterator last, Alloc allocator) {
+inline void __uninitialized_fill(const T &x, InputIterator first, InputIterator last,
+	Alloc &allocator, false_type) {
 	auto p = first;
-	for(;p != last;++p) {
-		allocator.construct(pointer_traits(p), x);
+	try {
+		for(;p != last;++p) {
+			allocator.construct(pointer_traits(p), x);
+		}
+	} catch(...) {
+		__rollback(first, p, allocator);
+		throw;
+	}
+}
+
+template <typename InputIterator, typename T, typename Alloc>
+inline void __uninitialized_fill(const T &x, InputIterator first, InputIterator last,
+	Alloc &, true_type) {
+	if(first != last) {
+		__fill_trivial(first, last - first, x);
 	}
 }
 
 template <typename InputIterator, typename Size, typename T, typename Alloc>
-void uninitialized_fill_n(const T &x, InputIterator first, Size size, Alloc allocator) {
+inline void __uninitialized_fill_n(const T &x, InputIterator first, Size size,
+	Alloc &allocator, false_type) {
+	auto p = first;
+	try {
+		for(Size s = 0;s < size;++s, ++p) {
+			allocator.construct(pointer_traits(p), x);
+		}
+	} catch(...) {
+		__rollback(first, p, allocator);
+		throw;
+	}
+}
+
+template <typename InputIterator, typename Size, typename T, typename Alloc>
+inline void __uninitialized_fill_n(const T &x, InputIterator first, Size size,
+	Alloc &, true_type) {
+	if(size > 0) {
+		__fill_trivial(first, size, x);
+	}
+}
+
+template <typename InputIterator, typename Size, typename Alloc>
+inline void __initialized_destory_n(InputIterator first, Size size, Alloc &allocator, false_type) {
 	auto p = first;
 	for(Size s = 0;s < size;++s, ++p) {
-		allocator.construct(pointer_traits(p), x);
+		allocator.destory(pointer_traits(p));
 	}
 }
 
+template <typename InputIterator, typename Size, typename Alloc>
+inline void __initialized_destory_n(InputIterator, Size, Alloc &, true_type) {
+}
+
 template <typename InputIterator, typename Alloc>
-void initialized_destory(InputIterator first, InputIterator last, Alloc allocator) {
+inline void __initialized_destory(InputIterator first, InputIterator last, Alloc &allocator, false_type) {
 	auto p = first;
 	for(;p != last;++p) {
 		allocator.destory(pointer_traits(p));
 	}
 }
 
+template <typename InputIterator, typename Alloc>
+inline void __initialized_destory(InputIterator, InputIterator, Alloc &, true_type) {
+}
+
+} // namespace
+
+// 以下函数对可平凡构造、复制或析构的类型分别使用内存置零、内存复制或跳过析构，
+// 此时不经由配置器的construct与destory
+// 构造过程中抛出异常时，已构造的对象均被析构
+
+template <typename InputIterator, typename ForwardIterator, typename Alloc>
+ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc allocator) {
+	__uninitialized_copy(first, last, result, allocator,
+		typename trivial_copy_traits<InputIterator, ForwardIterator>::type());
+	return result;
+}
+
+template <typename InputIterator, typename ForwardIterator, typename Alloc>
+ForwardIterator uninitialized_move(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc allocator) {
+	__uninitialized_move(first, last, result, allocator,
+		typename trivial_copy_traits<InputIterator, ForwardIterator>::type());
+	return result;
+}
+
+template <typename InputIterator, typename ForwardIterator, typename Alloc>
+ForwardIterator uninitialized_move_if_noexcept(InputIterator first, InputIterator last,
+	ForwardIterator result, Alloc allocator) {
+	__uninitialized_move_if_noexcept(first, last, result, allocator,
+		typename trivial_copy_traits<InputIterator, ForwardIterator>::type());
+	return result;
+}
+
+template <typename InputIterator, typename Alloc>
+void uninitialized_fill(InputIterator first, InputIterator last, Alloc allocator) {
+	__uninitialized_fill(first, last, allocator,
+		typename trivial_fill_traits<InputIterator>::type());
+}
+
+template <typename InputIterator, typename Size, typename Alloc>
+void uninitialized_fill_n(InputIterator first, Size size, Alloc allocator) {
+	__uninitialized_fill_n(first, size, allocator,
+		typename trivial_fill_traits<InputIterator>::type());
+}
+
+// 默认初始化，可平凡默认构造的类型不写入内存，内容未定
+template <typename InputIterator, typename Alloc>
+void uninitialized_default_fill(InputIterator first, InputIterator last, Alloc allocator) {
+	__uninitialized_default_fill(first, last, allocator,
+		typename type_traits<typename iterator_traits<InputIterator>::value_type>::has_trivial_default_constructor());
+}
+
+template <typename InputIterator, typename T, typename Alloc>
+void uninitialized_fill(const T &x, InputIterator first, InputIterator last, Alloc allocator) {
+	__uninitialized_fill(x, first, last, allocator,
+		typename trivial_fill_value_traits<InputIterator>::type());
+}
+
+template <typename InputIterator, typename Size, typename T, typename Alloc>
+void uninitialized_fill_n(const T &x, InputIterator first, Size size, Alloc allocator) {
+	__uninitialized_fill_n(x, first, size, allocator,
+		typename trivial_fill_value_traits<InputIterator>::type());
+}
+
+template <typename InputIterator, typename Alloc>
+void initialized_destory(InputIterator first, InputIterator last, Alloc allocator) {
+	__initialized_destory(first, last, allocator,
+		typename type_traits<typename iterator_traits<InputIterator>::value_type>::has_trivial_destructor());
+}
+
 template <typename InputIterator, typename Size, typename Alloc>
 void initialized_destory_n(InputIterator first, Size size, Alloc allocator) {
-	auto p = first;
-	for(Size s = 0;s < size;++s, ++p) {
-		allocator.destory(pointer_traits(p));
-	}
+	__initialized_destory_n(first, size, allocator,
+		typename type_traits<typename iterator_traits<InputIterator>::value_type>::has_trivial_destructor());
 }
 
 } // namespace stl
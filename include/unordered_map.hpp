@@ -43,22 +43,25 @@ public:
 	UnorderedMap() :ht() {
 	}
 
-	UnorderedMap(const UnorderedMap &other) :ht(other) {
+	explicit UnorderedMap(const ALLOC &allocator) :ht(allocator) {
 	}
 
-	UnorderedMap(UnorderedMap &&other) :ht(stl::move(other)) {
+	UnorderedMap(const UnorderedMap &other) :ht(other.ht) {
+	}
+
+	UnorderedMap(UnorderedMap &&other) :ht(stl::move(other.ht)) {
 	}
 
 	UnorderedMap &operator=(const UnorderedMap &other) {
 		if(this != &other) {
-			*this = other;
+			ht = other.ht;
 		}
 		return *this;
 	}
 
 	UnorderedMap &operator=(UnorderedMap &&other) {
 		if(this != &other) {
-			*this = stl::move(other);
+			ht = stl::move(other.ht);
 		}
 		return *this;
 	}
@@ -106,7 +109,7 @@ public:
 
 	void swap(UnorderedMap &s) {
 		if(this != &s) {
-			s.swap(*this);
+			ht.swap(s.ht);
 		}
 	}
 
@@ -184,22 +187,25 @@ public:
 	UnorderedMultiMap() :ht() {
 	}
 
-	UnorderedMultiMap(const UnorderedMultiMap &other) :ht(other) {
+	explicit UnorderedMultiMap(const ALLOC &allocator) :ht(allocator) {
+	}
+
+	UnorderedMultiMap(const UnorderedMultiMap &other) :ht(other.ht) {
 	}
 
-	UnorderedMultiMap(UnorderedMultiMap &&other) :ht(stl::move(other)) {
+	UnorderedMultiMap(UnorderedMultiMap &&other) :ht(stl::move(other.ht)) {
 	}
 
 	UnorderedMultiMap &operator=(const UnorderedMultiMap &other) {
 		if(this != &other) {
-			*this = other;
+			ht = other.ht;
 		}
 		return *this;
 	}
 
 	UnorderedMultiMap &operator=(UnorderedMultiMap &&other) {
 		if(this != &other) {
-			*this = stl::move(other);
+			ht = stl::move(other.ht);
 		}
 		return *this;
 	}
@@ -247,7 +253,7 @@ public:
 
 	void swap(UnorderedMultiMap &s) {
 		if(this != &s) {
-			s.swap(*this);
+			ht.swap(s.ht);
 		}
 	}
 
@@ -276,6 +282,17 @@ public:
 	}
 };
 
+// 仅持有一个哈希表，与哈希表同样可按位搬移
+template <typename Key, typename Value, typename Hash, typename KeyEqual, typename ALLOC>
+struct is_trivially_relocatable<UnorderedMap<Key, Value, Hash, KeyEqual, ALLOC>> :
+	members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<UnorderedMap<Key, Value, Hash, KeyEqual, ALLOC>>
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual, typename ALLOC>
+struct is_trivially_relocatable<UnorderedMultiMap<Key, Value, Hash, KeyEqual, ALLOC>> :
+	members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<UnorderedMultiMap<Key, Value, Hash, KeyEqual, ALLOC>>
+
 } // namespace stl
 
 #endif // _UNORDERED_MAP_HPP__
\ No newline at end of file
@@ -37,22 +37,25 @@ public:
 	UnorderedSet() :ht() {
 	}
 
-	UnorderedSet(const UnorderedSet &other) :ht(other) {
+	explicit UnorderedSet(const ALLOC &allocator) :ht(allocator) {
 	}
 
-	UnorderedSet(UnorderedSet &&other) :ht(stl::move(other)) {
+	UnorderedSet(const UnorderedSet &other) :ht(other.ht) {
+	}
+
+	UnorderedSet(UnorderedSet &&other) :ht(stl::move(other.ht)) {
 	}
 
 	UnorderedSet &operator=(const UnorderedSet &other) {
 		if(this != &other) {
-			*this = other;
+			ht = other.ht;
 		}
 		return *this;
 	}
 
 	UnorderedSet &operator=(UnorderedSet &&other) {
 		if(this != &other) {
-			*this = stl::move(other);
+			ht = stl::move(other.ht);
 		}
 		return *this;
 	}
@@ -100,7 +103,7 @@ public:
 
 	void swap(UnorderedSet &s) {
 		if(this != &s) {
-			s.swap(*this);
+			ht.swap(s.ht);
 		}
 	}
 
@@ -159,22 +162,25 @@ public:
 	UnorderedMultiSet() :ht() {
 	}
 
-	UnorderedMultiSet(const UnorderedMultiSet &other) :ht(other) {
+	explicit UnorderedMultiSet(const ALLOC &allocator) :ht(allocator) {
+	}
+
+	UnorderedMultiSet(const UnorderedMultiSet &other) :ht(other.ht) {
 	}
 
-	UnorderedMultiSet(UnorderedMultiSet &&other) :ht(stl::move(other)) {
+	UnorderedMultiSet(UnorderedMultiSet &&other) :ht(stl::move(other.ht)) {
 	}
 
 	UnorderedMultiSet &operator=(const UnorderedMultiSet &other) {
 		if(this != &other) {
-			*this = other;
+			ht = other.ht;
 		}
 		return *this;
 	}
 
 	UnorderedMultiSet &operator=(UnorderedMultiSet &&other) {
 		if(this != &other) {
-			*this = stl::move(other);
+			ht = stl::move(other.ht);
 		}
 		return *this;
 	}
@@ -222,7 +228,7 @@ public:
 
 	void swap(UnorderedMultiSet &s) {
 		if(this != &s) {
-			s.swap(*this);
+			ht.swap(s.ht);
 		}
 	}
 
@@ -251,6 +257,15 @@ public:
 	}
 }; // class UnorderedMultiSet
 
+// 仅持有一个哈希表，与哈希表同样可按位搬移
+template <typename Key, typename Hash, typename KeyEqual, typename ALLOC>
+struct is_trivially_relocatable<UnorderedSet<Key, Hash, KeyEqual, ALLOC>> :members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<UnorderedSet<Key, Hash, KeyEqual, ALLOC>>
+
+template <typename Key, typename Hash, typename KeyEqual, typename ALLOC>
+struct is_trivially_relocatable<UnorderedMultiSet<Key, Hash, KeyEqual, ALLOC>> :members_trivially_relocatable<ALLOC> {
+}; // struct is_trivially_relocatable<UnorderedMultiSet<Key, Hash, KeyEqual, ALLOC>>
+
 } // namespace stl
 
 
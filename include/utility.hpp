@@ -1,6 +1,8 @@
 #ifndef _UTILITY_HPP__
 #define _UTILITY_HPP__
 
+#include "type_traits.hpp"
+
 namespace stl {
 
 template<typename T>
@@ -34,7 +36,8 @@ struct Pair {
 	Pair(const Pair &p) :first(p.first), second(p.second) {
 	}
 
-	Pair(Pair &&p) :first(move(p.first)), second(move(p.second)) {
+	Pair(Pair &&p) noexcept(std::is_nothrow_move_constructible<T1>::value &&
+		std::is_nothrow_move_constructible<T2>::value) :first(move(p.first)), second(move(p.second)) {
 	}
 
 	bool operator<(const Pair &p) {
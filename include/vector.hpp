@@ -1,14 +1,19 @@
 #ifndef _VECTOR_HPP__
 #define _VECTOR_HPP__
 
+#include <string.h>
+
 #include "allocator.hpp"
 #include "iterator.hpp"
 #include "uninitialized.hpp"
+#include "relocate.hpp"
 #include "reverse_iterator.hpp"
+#include "type_traits.hpp"
+#include "growth_policy.hpp"
 
 namespace stl {
 
-template <typename T, typename ALLOCATOR = Allocator<T>>
+template <typename T, typename ALLOCATOR = Allocator<T>, typename GROWTH = DoubleGrowth>
 class Vector {
 public:
 	using value_type = T;
@@ -23,6 +28,9 @@ public:
 	using const_iterator = const_pointer;
 	using reverse_iterator = ReverseIterator<iterator>;
 	using const_reverse_iterator = const ReverseIterator<iterator>;
+
+	// data()返回地址的对齐保证，由配置器决定
+	static constexpr size_type data_alignment = allocator_traits<ALLOCATOR>::alignment;
 private:
 	ALLOCATOR m_allocator_;
 
@@ -30,19 +38,149 @@ private:
 	iterator m_last_;
 	iterator m_end_of_storage_;
 
-	// 获取应分配内存大小
+	// 获取应分配内存大小，由扩容策略决定，分配时再由配置器按大小类取整
 	size_type new_memory(size_type cap) {
-		if(cap == 0) {
-			return 1;
+		return GROWTH::grow(capacity(), cap, sizeof(value_type));
+	}
+
+	// 可按位搬移的类型尝试由配置器直接调整内存，免去逐个搬移元素
+	bool try_reallocate(size_type ncap, true_type) {
+		if(m_start_ == nullptr) {
+			return false;
+		}
+		size_type si = size();
+		pointer p = allocator_traits<ALLOCATOR>::reallocate(m_allocator_, m_start_, capacity(), ncap);
+		if(p == nullptr) {
+			return false;
+		}
+		m_start_ = p;
+		m_last_ = p + si;
+		m_end_of_storage_ = p + ncap;
+		return true;
+	}
+
+	bool try_reallocate(size_type, false_type) {
+		return false;
+	}
+
+	bool try_reallocate(size_type ncap) {
+		return try_reallocate(ncap, typename is_trivially_relocatable<T>::type());
+	}
+
+	// 尝试由配置器原地扩展容量，地址不变，适用于任意类型
+	bool try_expand(size_type ncap) {
+		if(m_start_ == nullptr ||
+			!allocator_traits<ALLOCATOR>::try_expand(m_allocator_, m_start_, capacity(), ncap)) {
+			return false;
+		}
+		m_end_of_storage_ = m_start_ + ncap;
+		return true;
+	}
+
+	// 尝试不逐个搬移元素地扩展容量
+	bool try_grow(size_type ncap) {
+		return try_expand(ncap) || try_reallocate(ncap);
+	}
+
+	// 将原有元素搬移至容量为ncap的新内存p，pos之后的元素后移gap个位置，
+	// [p + (pos - m_start_), p + (pos - m_start_) + gap)中的新元素须已由调用者构造
+	// 搬移抛出异常时析构p中已构造的对象并释放p，原有元素保持不变
+	void relocate_storage(pointer p, size_type ncap, pointer pos, size_type gap) {
+		size_type si = size();
+		try {
+			relocate_range(m_start_, pos, m_last_, p, gap, m_allocator_);
+		} catch(...) {
+			m_allocator_.deallocate(p, ncap);
+			throw;
+		}
+		if(m_start_) {
+			m_allocator_.deallocate(m_start_, m_end_of_storage_ - m_start_);
+		}
+		m_start_ = p;
+		m_last_ = p + si + gap;
+		m_end_of_storage_ = p + ncap;
+	}
+
+	// 元素类型是否可按位搬移
+	static constexpr bool trivially_relocatable = tag_value<typename is_trivially_relocatable<T>::type>::value;
+
+	// 分配至少容纳n个对象的内存，n更新为实际可容纳的数量
+	pointer allocate_at_least(size_type &n) {
+		AllocationResult<pointer> res = allocator_traits<ALLOCATOR>::allocate_at_least(m_allocator_, n);
+		n = res.count;
+		return res.ptr;
+	}
+
+	// 扩展容量至不少于ncap，不改变元素
+	void grow_storage(size_type ncap) {
+		if(!try_grow(ncap)) {
+			auto p = allocate_at_least(ncap);
+			relocate_storage(p, ncap, m_last_, 0);
+		}
+	}
+
+	// 在新内存中于尾部构造元素后搬移原有元素
+	template <typename ... Args>
+	void emplace_back_relocate(size_type ncap, Args&& ... args) {
+		auto p = allocate_at_least(ncap);
+		try {
+			m_allocator_.construct(p + size(), std::forward<Args>(args)...);
+		} catch(...) {
+			m_allocator_.deallocate(p, ncap);
+			throw;
+		}
+		relocate_storage(p, ncap, m_last_, 1);
+	}
+
+	// emplace_back容量不足时的路径，与快速路径分离以便内联
+	template <typename ... Args>
+	void emplace_back_grow(Args&& ... args) {
+		auto ncap = new_memory(capacity() + 1);
+		if(try_expand(ncap)) {
+			m_allocator_.construct(m_last_, std::forward<Args>(args)...);
+			++m_last_;
+		} else if(trivially_relocatable && m_start_ != nullptr) {
+			// 参数可能引用容器内的元素，调整内存前先行构造
+			value_type value(std::forward<Args>(args)...);
+			if(try_reallocate(ncap)) {
+				m_allocator_.construct(m_last_, std::move(value));
+				++m_last_;
+			} else {
+				emplace_back_relocate(ncap, std::move(value));
+			}
+		} else {
+			// 新元素先于原有元素构造，参数可能引用容器内的元素
+			emplace_back_relocate(ncap, std::forward<Args>(args)...);
 		}
-		size_type ncap = capacity();
-		if(ncap == 0) {
-			return cap;
+	}
+
+	template <typename I>
+	void append(I first, I last, input_iterator_tag) {
+		for(;first != last;++first) {
+			emplace_back(*first);
 		}
-		while(ncap < cap) {
-			ncap <<= 1;
+	}
+
+	template <typename I>
+	void append(I first, I last, forward_iterator_tag) {
+		size_type n = stl::distance(first, last);
+		if(n > size_type(m_end_of_storage_ - m_last_)) {
+			// 区间可能位于容器内，不调整内存地址
+			auto ncap = new_memory(size() + n);
+			if(!try_expand(ncap)) {
+				auto p = allocate_at_least(ncap);
+				try {
+					uninitialized_copy(first, last, p + size(), m_allocator_);
+				} catch(...) {
+					m_allocator_.deallocate(p, ncap);
+					throw;
+				}
+				relocate_storage(p, ncap, m_last_, n);
+				return;
+			}
 		}
-		return ncap;
+		uninitialized_copy(first, last, m_last_, m_allocator_);
+		m_last_ += n;
 	}
 public:
 	Vector() :
@@ -51,6 +189,13 @@ public:
 		m_end_of_storage_(nullptr) {
 	}
 
+	explicit Vector(const ALLOCATOR &allocator) :
+		m_allocator_(allocator),
+		m_start_(nullptr),
+		m_last_(nullptr),
+		m_end_of_storage_(nullptr) {
+	}
+
 	explicit Vector(size_type n) :
 		m_start_(m_allocator_.allocate(n)),
 		m_last_(m_start_ + n),
@@ -79,14 +224,16 @@ public:
 		uninitialized_copy(first, last, m_start_, m_allocator_);
 	}
 
-	Vector(const Vector<T, ALLOCATOR> &v) :
+	Vector(const Vector &v) :
+		m_allocator_(v.m_allocator_),
 		m_start_(m_allocator_.allocate(v.capacity())),
 		m_last_(m_start_ + v.size()),
 		m_end_of_storage_(m_start_ + v.capacity()) {
 		uninitialized_copy(v.m_start_, v.m_last_, m_start_, m_allocator_);
 	}
 
-	Vector(Vector<T, ALLOCATOR> &&v) :
+	Vector(Vector &&v) noexcept :
+		m_allocator_(v.m_allocator_),
 		m_start_(v.m_start_),
 		m_last_(v.m_last_),
 		m_end_of_storage_(v.m_end_of_storage_) {
@@ -99,7 +246,7 @@ public:
 		clear();
 	}
 
-	inline Vector<T, ALLOCATOR> &operator=(const Vector<T, ALLOCATOR> &v) {
+	inline Vector &operator=(const Vector &v) {
 		if(this != &v) {
 			clear();
 
@@ -112,10 +259,11 @@ public:
 		return *this;
 	}
 
-	inline Vector<T, ALLOCATOR> &operator=(Vector<T, ALLOCATOR> &&v) {
+	inline Vector &operator=(Vector &&v) {
 		if(this != &v) {
 			clear();
 
+			m_allocator_ = v.m_allocator_;
 			m_start_ = v.m_start_;
 			m_last_ = v.m_last_;
 			m_end_of_storage_ = v.m_end_of_storage_;
@@ -127,19 +275,20 @@ public:
 		return *this;
 	}
 
-	void swap(Vector<T, ALLOCATOR> &v) {
+	void swap(Vector &v) {
 		if(this != &v) {
+			std::swap(m_allocator_, v.m_allocator_);
 			std::swap(m_start_, v.m_start_);
 			std::swap(m_last_, v.m_last_);
 			std::swap(m_end_of_storage_, v.m_end_of_storage_);
 		}
 	}
 
-	template <typename U, typename P>
-	friend void swap(Vector<U, P> &v, Vector<U, P> &vv);
+	template <typename U, typename P, typename G>
+	friend void swap(Vector<U, P, G> &v, Vector<U, P, G> &vv);
 
 	//比较操作相关
-	bool operator==(const Vector<T, ALLOCATOR> &v) const {
+	bool operator==(const Vector &v) const {
 		if(v.size() != size()) {
 			return false;
 		}
@@ -152,7 +301,7 @@ public:
 		return true;
 	}
 
-	bool operator!=(const Vector<T, ALLOCATOR> &v) const {
+	bool operator!=(const Vector &v) const {
 		return !operator==(v);
 	}
 
@@ -227,15 +376,7 @@ public:
 				uninitialized_fill(m_last_, m_start_ + n, m_allocator_);
 				m_last_ = m_start_ + n;
 			} else {
-				size_type ncap = new_memory(n);
-				auto p = m_allocator_.allocate(ncap, m_start_);
-				if(m_start_ != nullptr) {
-					uninitialized_move(m_start_, m_last_, p, m_allocator_);
-				}
-				clear();
-				m_start_ = p;
-				m_last_ = p + sn;
-				m_end_of_storage_ = p + ncap;
+				grow_storage(new_memory(n));
 				uninitialized_fill(m_last_, m_start_ + n, m_allocator_);
 				m_last_ = m_start_ + n;
 			}
@@ -257,36 +398,34 @@ public:
 				uninitialized_fill(x, m_last_, m_start_ + n, m_allocator_);
 				m_last_ = m_start_ + n;
 			} else {
-				size_type ncap = new_memory(n);
-				auto p = m_allocator_.allocate(ncap, m_start_);
-				if(m_start_ != nullptr) {
-					uninitialized_move(m_start_, m_last_, p, m_allocator_);
-				}
-				clear();
-				m_start_ = p;
-				m_last_ = p + sn;
-				m_end_of_storage_ = p + ncap;
+				grow_storage(new_memory(n));
 				uninitialized_fill(x, m_last_, m_start_ + n, m_allocator_);
 				m_last_ = m_start_ + n;
 			}
 		}
 	}
 
-	void reserve(size_type n) {
-		auto cap = capacity();
-		auto si = size();
-		if(cap >= n) {
+	// 新增元素默认初始化，可平凡默认构造的类型不写入内存，内容未定，
+	// 适用于随后即被填满的读缓冲区等
+	void resize_default_init(size_type n) {
+		if(n <= size()) {
+			resize(n);
 			return;
 		}
-		auto p = m_allocator_.allocate(n);
-		if(m_start_ != nullptr) {
-			uninitialized_move(m_start_, m_last_, p, m_allocator_);
+		if(n > capacity()) {
+			grow_storage(new_memory(n));
 		}
-		clear();
+		uninitialized_default_fill(m_last_, m_start_ + n, m_allocator_);
+		m_last_ = m_start_ + n;
+	}
 
-		m_start_ = p;
-		m_last_ = m_start_ + si;
-		m_end_of_storage_ = m_start_ + n;
+	void reserve(size_type n) {
+		auto cap = capacity();
+		if(cap >= n || try_grow(n)) {
+			return;
+		}
+		auto p = allocate_at_least(n);
+		relocate_storage(p, n, m_last_, 0);
 	}
 
 	void shrink_to_fit() {
@@ -296,12 +435,7 @@ public:
 			return;
 		}
 		auto p = m_allocator_.allocate(si);
-		uninitialized_move(m_start_, m_last_, p, m_allocator_);
-		clear();
-
-		m_start_ = p;
-		m_last_ = m_start_ + si;
-		m_end_of_storage_ = m_last_;
+		relocate_storage(p, si, m_last_, 0);
 	}
 
 	// 元素相关
@@ -338,11 +472,19 @@ public:
 	}
 
 	inline pointer data() {
+#ifdef __GNUC__
+		return static_cast<pointer>(__builtin_assume_aligned(m_start_, data_alignment));
+#else
 		return m_start_;
+#endif
 	}
 
 	inline const_pointer data() const {
+#ifdef __GNUC__
+		return static_cast<const_pointer>(__builtin_assume_aligned(m_start_, data_alignment));
+#else
 		return m_start_;
+#endif
 	}
 
 	// 增删操作
@@ -353,86 +495,65 @@ public:
 	iterator insert(iterator pos, size_type n, const value_type &elem) {
 		auto need_cap = size() + n;
 		if(need_cap > capacity()) {
+			// 原地扩展不改变pos，调整内存仅在尾部插入时使用
 			auto ncap = new_memory(need_cap);
-			auto p = m_allocator_.allocate(ncap);
-			auto dis = distance(m_start_, pos);
-			uninitialized_move(m_start_, pos, p, m_allocator_);
-			uninitialized_fill_n(elem, p + dis, n, m_allocator_);
-			uninitialized_move(pos, m_last_, p + dis + n, m_allocator_);
-
-			clear();
-
-			m_start_ = p;
-			m_last_ = p + need_cap;
-			m_end_of_storage_ = p + ncap;
-
-			return m_start_ + dis;
-		} else {
-			auto move_number = distance(pos, m_last_);
-			if(move_number > n) {
-				// 构造尾部
-				uninitialized_move(m_last_ - n, m_last_, m_last_, m_allocator_);
-
-				// 赋值尾部
-				auto e = m_last_ - (move_number - n) - 1;
-				for(auto i = m_last_ - 1;i != e;--i) {
-					*(i) = std::move(*(i - n));
-				}
-
-				// 赋值中部
-				for(size_t i = 0;i < n;++i) {
-					*(pos + i) = elem;
-				}
-			} else {
-				// 构造尾部
-				uninitialized_move(pos, m_last_, pos + n, m_allocator_);
-
-				// 构造中部
-				uninitialized_fill_n(elem, m_last_, n - move_number, m_allocator_);
-
-				// 赋值中部
-				for(auto p = pos;p != m_last_;++p) {
-					*p = elem;
+			if(!try_expand(ncap) && trivially_relocatable && pos == m_last_) {
+				if(&elem >= m_start_ && &elem < m_last_) {
+					// elem引用容器内的元素，调整内存后即失效，先行复制
+					value_type value(elem);
+					if(try_reallocate(ncap)) {
+						return insert(m_last_, n, value);
+					}
+				} else if(try_reallocate(ncap)) {
+					pos = m_last_;
 				}
 			}
-			m_last_ += n;
-			return pos;
 		}
+		if(need_cap > capacity()) {
+			auto ncap = new_memory(need_cap);
+			auto p = allocate_at_least(ncap);
+			auto dis = distance(m_start_, pos);
+			// 先构造新元素，elem可能引用容器内的元素
+			try {
+				uninitialized_fill_n(elem, p + dis, n, m_allocator_);
+			} catch(...) {
+				m_allocator_.deallocate(p, ncap);
+				throw;
+			}
+			relocate_storage(p, ncap, pos, n);
+			return m_start_ + dis;
+		}
+		inplace_insert_fill(pos, m_last_, n, elem, m_allocator_);
+		m_last_ += n;
+		return pos;
 	}
 
 	iterator insert(iterator pos, value_type &&elem) {
+		if(m_last_ >= m_end_of_storage_) {
+			// 原地扩展不改变pos，调整内存仅在尾部插入时使用
+			auto ncap = new_memory(capacity() + 1);
+			if(!try_expand(ncap) && pos == m_last_ && try_reallocate(ncap)) {
+				pos = m_last_;
+			}
+		}
 		if(m_last_ >= m_end_of_storage_) {
 			auto cap = capacity() + 1;
 			auto ncap = new_memory(cap);
-			auto p = m_allocator_.allocate(ncap);
+			auto p = allocate_at_least(ncap);
 			auto dis = distance(m_start_, pos);
 
-			uninitialized_move(m_start_, pos, p, m_allocator_);
-			m_allocator_.construct(p + dis, std::move(elem));
-			uninitialized_move(pos, m_last_, p + dis + 1, m_allocator_);
-
-			clear();
-
-			m_start_ = p;
-			m_last_ = p + cap;
-			m_end_of_storage_ = p + ncap;
-
-			return m_start_ + dis;
-		} else {
-			if(pos != m_last_) {
-				auto p = m_last_;
-				m_allocator_.construct(p, std::move(*(p - 1)));
-				--p;
-				for(;p != pos;--p) {
-					*p = std::move(*(p - 1));
-				}
-				*pos = std::move(elem);
-			} else {
-				m_allocator_.construct(pos, std::move(elem));
+			try {
+				m_allocator_.construct(p + dis, std::move(elem));
+			} catch(...) {
+				m_allocator_.deallocate(p, ncap);
+				throw;
 			}
-			++m_last_;
-			return pos;
+			relocate_storage(p, ncap, pos, 1);
+			return m_start_ + dis;
 		}
+		inplace_insert_move(pos, m_last_, std::move(elem), m_allocator_);
+		++m_last_;
+		return pos;
 	}
 
 	template <typename I>
@@ -440,80 +561,53 @@ public:
 		auto n = distance(first, last);
 		auto need_cap = size() + n;
 		if(need_cap > capacity()) {
+			// 原地扩展不改变pos，调整内存仅在尾部插入时使用
 			auto ncap = new_memory(need_cap);
-			auto p = m_allocator_.allocate(ncap);
+			if(!try_expand(ncap) && pos == m_last_ && try_reallocate(ncap)) {
+				pos = m_last_;
+			}
+		}
+		if(need_cap > capacity()) {
+			auto ncap = new_memory(need_cap);
+			auto p = allocate_at_least(ncap);
 			auto dis = distance(m_start_, pos);
-			uninitialized_move(m_start_, pos, p, m_allocator_);
-			uninitialized_copy(first, last, p + dis, m_allocator_);
-			uninitialized_move(pos, m_last_, p + dis + n, m_allocator_);
-
-			clear();
-
-			m_start_ = p;
-			m_last_ = p + need_cap;
-			m_end_of_storage_ = p + ncap;
-
-			return m_start_ + dis;
-		} else {
-			auto move_number = distance(pos, m_last_);
-			if(move_number > n) {
-				// 构造尾部
-				uninitialized_move(m_last_ - n, m_last_, m_last_, m_allocator_);
-
-				// 赋值尾部
-				auto e = m_last_ - (move_number - n) - 1;
-				for(auto i = m_last_ - 1;i != e;--i) {
-					*(i) = std::move(*(i - n));
-				}
-
-				// 赋值中部
-				for(size_t i = 0;i < n;++i) {
-					*(pos + i) = *(first + i);
-				}
-			} else {
-				// 构造尾部
-				uninitialized_move(pos, m_last_, pos + n, m_allocator_);
-
-				// 构造中部
-				uninitialized_copy(first + move_number, last, m_last_, m_allocator_);
-
-				// 赋值中部
-				for(auto p = pos;p != m_last_;++p, ++first) {
-					*p = *first;
-				}
+			try {
+				uninitialized_copy(first, last, p + dis, m_allocator_);
+			} catch(...) {
+				m_allocator_.deallocate(p, ncap);
+				throw;
 			}
-			m_last_ += n;
-			return pos;
+			relocate_storage(p, ncap, pos, n);
+			return m_start_ + dis;
 		}
-		return m_start_;
+		inplace_insert_range(pos, m_last_, first, last, n, m_allocator_);
+		m_last_ += n;
+		return pos;
 	}
 
-	void push_back(const value_type &elem) {
-		insert(end(), elem);
+	inline void push_back(const value_type &elem) {
+		emplace_back(elem);
 	}
 
-	void push_back(value_type &&elem) {
-		insert(end(), std::move(elem));
+	inline void push_back(value_type &&elem) {
+		emplace_back(std::move(elem));
 	}
 
+	// 容量充足时仅构造元素
 	template <typename ... Args>
-	void emplace_back(Args&& ... args) {
-		if(m_last_ >= m_end_of_storage_) {
-			auto cap = capacity() + 1;
-			auto si = size();
-			auto ncap = new_memory(cap);
-			auto p = m_allocator_.allocate(ncap);
-
-			uninitialized_move(m_start_, m_last_, p, m_allocator_);
-			clear();
-
-			m_start_ = p;
-			m_last_ = p + si;
-			m_end_of_storage_ = p + ncap;
+	inline void emplace_back(Args&& ... args) {
+		if(m_last_ != m_end_of_storage_) {
+			m_allocator_.construct(m_last_, std::forward<Args>(args)...);
+			++m_last_;
+			return;
 		}
+		emplace_back_grow(std::forward<Args>(args)...);
+	}
 
-		m_allocator_.construct(m_last_, std::forward<Args>(args)...);
-		++m_last_;
+	// 在尾部追加[first, last)，前向迭代器仅扩容一次
+	template <typename I>
+	void append(I first, I last) {
+		append(first, last, iterator_category(first));
 	}
 
 	iterator erase(iterator pos) {
@@ -522,10 +616,7 @@ public:
 
 	iterator erase(iterator first, iterator last) {
 		auto n = distance(first, last);
-		for(auto p = last;p != m_last_;++p) {
-			*(p - n) = *p;
-		}
-		initialized_destory(m_last_ - n, m_last_, m_allocator_);
+		inplace_erase(first, last, m_last_, m_allocator_);
 		m_last_ -= n;
 		return first;
 	}
@@ -540,11 +631,25 @@ public:
 	}
 };
 
-template <typename T, typename ALLOCATOR>
-void swap(Vector<T, ALLOCATOR> &v, Vector<T, ALLOCATOR> &vv) {
+template <typename T, typename ALLOCATOR, typename GROWTH>
+constexpr typename Vector<T, ALLOCATOR, GROWTH>::size_type Vector<T, ALLOCATOR, GROWTH>::data_alignment;
+
+template <typename T, typename ALLOCATOR, typename GROWTH>
+constexpr bool Vector<T, ALLOCATOR, GROWTH>::trivially_relocatable;
+
+// Vector仅持有配置器与指向堆上内存的指针，可按位搬移
+template <typename T, typename ALLOCATOR, typename GROWTH>
+struct is_trivially_relocatable<Vector<T, ALLOCATOR, GROWTH>> :members_trivially_relocatable<ALLOCATOR> {
+}; // struct is_trivially_relocatable<Vector<T, ALLOCATOR, GROWTH>>
+
+template <typename T, typename ALLOCATOR, typename GROWTH>
+void swap(Vector<T, ALLOCATOR, GROWTH> &v, Vector<T, ALLOCATOR, GROWTH> &vv) {
 	v.swap(vv);
 }
 
 } // namespace stl
 
+// Vector<bool>的按位压缩特化
+#include "bit_vector.hpp"
+
 #endif // _VECTOR_HPP__
\ No newline at end of file
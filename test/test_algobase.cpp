@@ -4,6 +4,28 @@
 #include "numeric.hpp"
 #include "vector.hpp"
 
+struct Point {
+	int x;
+	double y;
+};
+
+// 用户定义的聚合类型同样走整段复制，源与目标重叠时结果正确
+void test_copy_struct() {
+	std::cout << "Point trivial assignment: " << stl::tag_value<
+		stl::type_traits<Point>::has_trivial_assignment_operator>::value << std::endl;
+	Point points[8];
+	for(int i = 0;i < 8;++i) {
+		points[i].x = i;
+		points[i].y = i * 0.5;
+	}
+	Point *q = stl::copy(points + 2, points + 8, points);
+	std::cout << q - points << ':';
+	for(int i = 0;i < 8;++i) {
+		std::cout << ' ' << points[i].x;
+	}
+	std::cout << std::endl;
+}
+
 void main_func() {
 	stl::Vector<int> test1(10);
 
@@ -97,5 +119,6 @@ void main_func() {
 
 int main() {
 	main_func();
+	test_copy_struct();
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <iostream>
+
+#include "aligned_allocator.hpp"
+#include "vector.hpp"
+#include "array.hpp"
+
+template <typename P>
+bool aligned(P p, size_t align) {
+	return reinterpret_cast<uintptr_t>(p) % align == 0;
+}
+
+template <size_t Align>
+void test_vector() {
+	using AlignedVector = stl::Vector<float, stl::AlignedAllocator<float, Align>>;
+	bool ok = true;
+	for(size_t n = 1;n <= 4096;n = n * 3 + 1) {
+		AlignedVector vec;
+		for(size_t i = 0;i < n;++i) {
+			vec.push_back(static_cast<float>(i));
+			ok = ok && aligned(vec.data(), Align);
+		}
+		AlignedVector copy(vec);
+		ok = ok && aligned(copy.data(), Align) && copy.back() == vec.back();
+	}
+	std::cout << "vector<float> data_alignment " << AlignedVector::data_alignment
+		<< ": " << (ok ? "aligned" : "misaligned") << std::endl;
+}
+
+int main() {
+	test_vector<32>();
+	test_vector<64>();
+	test_vector<4096>();
+
+	std::cout << "default data_alignment: " << stl::Vector<float>::data_alignment << std::endl;
+
+	stl::AlignedAllocator<double, 64> alloc;
+	double *p = alloc.allocate(1);
+	std::cout << "single element: " << (aligned(p, 64) ? "aligned" : "misaligned") << std::endl;
+	alloc.deallocate(p, 1);
+
+	stl::Array<float, 16, 64> array0;
+	array0.fill(1.0f);
+	float sum = 0;
+	for(auto f : array0) {
+		sum += f;
+	}
+	std::cout << "array data_alignment " << stl::Array<float, 16, 64>::data_alignment << ": "
+		<< (aligned(array0.data(), 64) ? "aligned" : "misaligned") << ' ' << sum << std::endl;
+	return 0;
+}
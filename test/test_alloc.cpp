@@ -0,0 +1,236 @@
+#define _TINY_STL_MEMORY_POOL_
+
+#include <iostream>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "alloc.hpp"
+#include "list.hpp"
+#include "map.hpp"
+#include "unordered_map.hpp"
+#include "vector.hpp"
+
+struct Block {
+	unsigned char *p;
+	size_t n;
+};
+
+// 随机分配与回收，检查内存块互不重叠
+void test_random() {
+	stl::Alloc alloc;
+	stl::Vector<Block> blocks;
+	srand(1024);
+	for(int i = 0;i < 100000;++i) {
+		if(blocks.empty() || rand() % 3 != 0) {
+			Block b;
+			b.n = rand() % stl::Alloc::max_block_size + 1;
+			b.p = static_cast<unsigned char *>(alloc.allocate(b.n));
+			for(size_t j = 0;j < b.n;++j) {
+				b.p[j] = static_cast<unsigned char>(b.n);
+			}
+			blocks.push_back(b);
+		} else {
+			size_t idx = rand() % blocks.size();
+			Block b = blocks[idx];
+			for(size_t j = 0;j < b.n;++j) {
+				if(b.p[j] != static_cast<unsigned char>(b.n)) {
+					std::cout << "corrupted block of " << b.n << " bytes" << std::endl;
+					return;
+				}
+			}
+			alloc.deallocate(b.p, b.n);
+			blocks[idx] = blocks.back();
+			blocks.pop_back();
+		}
+	}
+	for(auto &b : blocks) {
+		alloc.deallocate(b.p, b.n);
+	}
+	std::cout << "random test done" << std::endl;
+}
+
+// 全部回收后再次分配应复用相同的地址
+void test_coalesce() {
+	stl::Alloc alloc;
+	void *first = alloc.allocate(stl::Alloc::max_block_size);
+	alloc.deallocate(first, stl::Alloc::max_block_size);
+
+	void *small[128];
+	for(int i = 0;i < 128;++i) {
+		small[i] = alloc.allocate(16);
+	}
+	for(int i = 0;i < 128;++i) {
+		alloc.deallocate(small[i], 16);
+	}
+
+	void *again = alloc.allocate(stl::Alloc::max_block_size);
+	std::cout << "coalesce: " << (again == first ? "ok" : "failed") << std::endl;
+	alloc.deallocate(again, stl::Alloc::max_block_size);
+}
+
+// 伙伴空闲时向量原地扩容，元素地址不变
+void test_expand() {
+	stl::Alloc alloc;
+	char *p = static_cast<char *>(alloc.allocate(16));
+	p[0] = 'x';
+	bool expanded = alloc.expand(p, 16, stl::Alloc::max_block_size);
+	std::cout << "expand: " << (!expanded || p[0] == 'x' ? "ok" : "failed") << std::endl;
+	alloc.deallocate(p, expanded ? stl::Alloc::max_block_size : 16);
+
+	stl::Vector<int> vec;
+	int in_place = 0;
+	size_t cap = 0;
+	int *data = nullptr;
+	for(int i = 0;i < 512;++i) {
+		vec.push_back(i);
+		if(vec.capacity() != cap) {
+			in_place += cap != 0 && vec.data() == data;
+			cap = vec.capacity();
+			data = vec.data();
+		}
+	}
+	bool ok = true;
+	for(int i = 0;i < 512;++i) {
+		ok = ok && vec[i] == i;
+	}
+	std::cout << "vector in-place growth: " << (in_place > 0 ? "yes" : "no")
+		<< " content: " << (ok ? "ok" : "broken") << std::endl;
+}
+
+// 完全空闲的内存池归还系统
+void test_trim() {
+	stl::Alloc alloc;
+	const int n = 1024;
+	void *blocks[n];
+	for(int i = 0;i < n;++i) {
+		blocks[i] = alloc.allocate(stl::Alloc::max_block_size);
+	}
+	for(int i = 0;i < n;++i) {
+		alloc.deallocate(blocks[i], stl::Alloc::max_block_size);
+	}
+	size_t bytes = stl::Alloc::trim();
+	std::cout << "trim: " << (bytes >= n / 2 * stl::Alloc::max_block_size ? "ok" : "failed") << std::endl;
+
+	// 立即衰减时，内存池在最后一块归还伙伴系统时即归还系统
+	stl::Alloc::set_decay_time(std::chrono::milliseconds(0));
+	size_t before = stl::Alloc::reclaimed_bytes();
+	for(int i = 0;i < n;++i) {
+		blocks[i] = alloc.allocate(stl::Alloc::max_block_size);
+	}
+	for(int i = 0;i < n;++i) {
+		alloc.deallocate(blocks[i], stl::Alloc::max_block_size);
+	}
+	std::cout << "decay: " << (stl::Alloc::reclaimed_bytes() > before ? "ok" : "failed") << std::endl;
+	stl::Alloc::set_decay_time(std::chrono::milliseconds(-1));
+
+	void *p = alloc.allocate(16);
+	alloc.deallocate(p, 16);
+}
+
+// 由已退出线程分配、本线程释放的内存块，trim时自空闲实例的远程回收队列中取回
+void test_trim_idle() {
+	const int n = 1024;
+	void *blocks[n];
+	std::thread worker([&]() {
+		stl::Alloc alloc;
+		for(int i = 0;i < n;++i) {
+			blocks[i] = alloc.allocate(stl::Alloc::max_block_size);
+		}
+	});
+	worker.join();
+	stl::Alloc alloc;
+	for(int i = 0;i < n;++i) {
+		alloc.deallocate(blocks[i], stl::Alloc::max_block_size);
+	}
+	size_t bytes = stl::Alloc::trim();
+	std::cout << "trim idle: " << (bytes >= n / 2 * stl::Alloc::max_block_size ? "ok" : "failed") << std::endl;
+}
+
+void test_container() {
+	stl::Map<int, int> map0;
+	stl::List<int> list0;
+	stl::UnorderedMap<int, int> umap0;
+	for(int i = 0;i < 10000;++i) {
+		map0[i] = i;
+		list0.push_back(i);
+		umap0.emplace(i, i);
+	}
+	for(int i = 0;i < 10000;i += 2) {
+		map0.erase(i);
+		list0.pop_front();
+	}
+	long long sum = 0;
+	for(auto &p : map0) {
+		sum += p.second;
+	}
+	for(int i : list0) {
+		sum += i;
+	}
+	std::cout << "size: " << map0.size() << ' ' << list0.size() << ' ' << umap0.size() << std::endl;
+	std::cout << "sum: " << sum << std::endl;
+}
+
+// 一个线程构造结点，另一个线程释放
+void test_cross_thread() {
+	std::mutex mutex;
+	std::condition_variable cv;
+	stl::Vector<stl::List<int> *> ready;
+	bool done = false;
+	long long sum = 0;
+
+	std::thread consumer([&]() {
+		for(;;) {
+			stl::Vector<stl::List<int> *> batch;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cv.wait(lock, [&]() {
+					return done || !ready.empty();
+				});
+				if(ready.empty() && done) {
+					break;
+				}
+				batch.swap(ready);
+			}
+			for(auto list : batch) {
+				for(int i : *list) {
+					sum += i;
+				}
+				delete list;
+			}
+		}
+	});
+
+	std::thread producer([&]() {
+		for(int round = 0;round < 1000;++round) {
+			stl::List<int> *list = new stl::List<int>();
+			for(int i = 0;i < 100;++i) {
+				list->push_back(i);
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			ready.push_back(list);
+			cv.notify_one();
+		}
+	});
+
+	producer.join();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		done = true;
+		cv.notify_one();
+	}
+	consumer.join();
+	std::cout << "cross thread sum: " << sum << std::endl;
+}
+
+int main() {
+	test_random();
+	test_coalesce();
+	test_expand();
+	test_trim();
+	test_trim_idle();
+	test_container();
+	test_cross_thread();
+	return 0;
+}
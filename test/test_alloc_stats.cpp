@@ -0,0 +1,94 @@
+#include <iostream>
+
+#include "alloc_stats.hpp"
+#include "vector.hpp"
+#include "list.hpp"
+#include "deque.hpp"
+#include "map.hpp"
+#include "unordered_map.hpp"
+
+// 区分同一元素类型的不同容器
+struct VectorTag {};
+struct ListTag {};
+
+using StatVector = stl::Vector<int, stl::StatAllocator<int, VectorTag>>;
+using StatList = stl::List<int, stl::StatAllocator<int, ListTag>>;
+using StatDeque = stl::Deque<long, 0, stl::StatAllocator<long>>;
+using StatMap = stl::Map<int, int, stl::less<int>,
+	stl::StatAllocator<stl::Pair<const int, int>>>;
+using StatUnorderedMap = stl::UnorderedMap<long, int, stl::stlHash<long>, stl::equal_to<long>,
+	stl::StatAllocator<stl::Pair<const long, int>>>;
+
+void print(const char *name, const stl::AllocStats &stats) {
+	std::cout << name << ": allocations " << stats.allocations()
+		<< " deallocations " << stats.deallocations()
+		<< " live " << stats.bytes_live()
+		<< " peak " << stats.peak_bytes() << std::endl;
+}
+
+void print_histogram(const stl::AllocStats &stats) {
+	for(size_t c = 0;c < stl::AllocStats::size_class_number;++c) {
+		if(stats.histogram(c) != 0) {
+			std::cout << "  <= " << (static_cast<size_t>(1) << c) << " B: "
+				<< stats.histogram(c) << std::endl;
+		}
+	}
+}
+
+// 默认Tag下元素类型相同的容器共用一条记录，传入不同的Tag后分开统计
+struct FirstTag {};
+struct SecondTag {};
+
+void test_tags() {
+	{
+		stl::Vector<short, stl::StatAllocator<short>> a, b;
+		stl::Vector<short, stl::StatAllocator<short, FirstTag>> c;
+		stl::Vector<short, stl::StatAllocator<short, SecondTag>> d;
+		a.reserve(10);
+		b.reserve(10);
+		c.reserve(10);
+		d.reserve(20);
+	}
+	std::cout << "shared tag allocations: " << stl::StatAllocator<short>::stats().allocations()
+		<< " first: " << stl::StatAllocator<short, FirstTag>::stats().allocations()
+		<< " second: " << stl::StatAllocator<short, SecondTag>::stats().allocations()
+		<< " " << stl::StatAllocator<short, SecondTag>::stats().peak_bytes() << std::endl;
+}
+
+int main() {
+	{
+		StatVector vec;
+		StatList list0;
+		StatDeque deque0;
+		StatMap map0;
+		StatUnorderedMap umap0;
+		for(int i = 0;i < 1000;++i) {
+			vec.push_back(i);
+			list0.push_back(i);
+			deque0.push_back(i);
+			map0[i] = i;
+			umap0.emplace(i, i);
+		}
+		print("vector", stl::StatAllocator<int, VectorTag>::stats());
+		print("list", stl::StatAllocator<int, ListTag>::stats());
+		print("deque", stl::StatAllocator<long>::stats());
+		print("map", stl::StatAllocator<stl::Pair<const int, int>>::stats());
+
+		// 哈希表的结点与桶数组均计入同一记录
+		const stl::AllocStats &umap_stats = stl::StatAllocator<stl::Pair<const long, int>>::stats();
+		print("unordered_map", umap_stats);
+		print_histogram(umap_stats);
+	}
+
+	test_tags();
+
+	size_t records = 0;
+	bool balanced = true;
+	stl::AllocStats::for_each([&](const stl::AllocStats &stats) {
+		++records;
+		balanced = balanced && stats.bytes_live() == 0 &&
+			stats.allocations() == stats.deallocations();
+	});
+	std::cout << "records: " << records << " balanced: " << (balanced ? "yes" : "no") << std::endl;
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+
+#include "arena.hpp"
+#include "vector.hpp"
+#include "list.hpp"
+#include "deque.hpp"
+#include "map.hpp"
+#include "unordered_map.hpp"
+
+using ArenaMap = stl::Map<int, int, stl::less<int>,
+	stl::ArenaAllocator<stl::Pair<const int, int>>>;
+using ArenaUnorderedMap = stl::UnorderedMap<int, int, stl::stlHash<int>, stl::equal_to<int>,
+	stl::ArenaAllocator<stl::Pair<const int, int>>>;
+
+// 模拟一次请求处理，临时容器全部构建在区域中
+long long handle_request(int n) {
+	stl::Vector<int, stl::ArenaAllocator<int>> vec;
+	stl::List<int, stl::ArenaAllocator<int>> list0;
+	stl::Deque<int, 0, stl::ArenaAllocator<int>> deque0;
+	ArenaMap map0;
+	ArenaUnorderedMap umap0;
+
+	for(int i = 0;i < n;++i) {
+		vec.push_back(i);
+		list0.push_back(i);
+		deque0.push_back(i);
+		map0[i] = i;
+		umap0.emplace(i, i);
+	}
+
+	long long sum = 0;
+	for(int i : vec) {
+		sum += i;
+	}
+	for(int i : list0) {
+		sum += i;
+	}
+	for(int i = 0;i < deque0.size();++i) {
+		sum += deque0[i];
+	}
+	for(auto &p : map0) {
+		sum += p.second;
+	}
+	return sum + umap0.size();
+}
+
+void test_scope() {
+	stl::Arena arena;
+	void *mark = arena.allocate(8);
+
+	for(int round = 0;round < 3;++round) {
+		stl::ArenaScope scope(arena);
+		std::cout << "request " << round << ": " << handle_request(1000) << std::endl;
+	}
+
+	// 回退后分配位置应紧随作用域之前的分配
+	void *next = arena.allocate(8);
+	std::cout << "rewind: " << (static_cast<char *>(next) ==
+		static_cast<char *>(mark) + alignof(std::max_align_t) ? "ok" : "failed") << std::endl;
+}
+
+void test_checkpoint() {
+	stl::Arena arena(256);
+	auto cp = arena.checkpoint();
+	void *first = arena.allocate(100);
+	for(int i = 0;i < 100;++i) {
+		arena.allocate(1000);
+	}
+	arena.rewind(cp);
+	void *again = arena.allocate(100);
+	std::cout << "checkpoint: " << (first == again ? "ok" : "failed") << std::endl;
+
+	void *aligned = arena.allocate(1, 64);
+	std::cout << "align: " << (reinterpret_cast<uintptr_t>(aligned) % 64 == 0 ? "ok" : "failed") << std::endl;
+}
+
+int main() {
+	test_scope();
+	test_checkpoint();
+	return 0;
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#include "vector.hpp"
+#include "algorithm.hpp"
+
+#include "test_util.hpp"
+
+using BitVector = stl::Vector<bool>;
+
+// 与std::vector<bool>对照增删操作
+bool test_ops() {
+	BitVector bv;
+	std::vector<bool> ref;
+	unsigned seed = 7;
+	auto next = [&seed]() {
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 16) & 0x7fff;
+	};
+	for(int i = 0;i < 2000;++i) {
+		bool x = next() & 1;
+		bv.push_back(x);
+		ref.push_back(x);
+	}
+	for(int i = 0;i < 200;++i) {
+		size_t pos = next() % (ref.size() + 1);
+		size_t n = next() % 150;
+		bool x = next() & 1;
+		bv.insert(bv.begin() + pos, n, x);
+		ref.insert(ref.begin() + pos, n, x);
+		pos = next() % ref.size();
+		n = next() % 100;
+		n = pos + n > ref.size() ? ref.size() - pos : n;
+		bv.erase(bv.begin() + pos, bv.begin() + pos + n);
+		ref.erase(ref.begin() + pos, ref.begin() + pos + n);
+	}
+	bool src[] = { true, false, true, true, false };
+	bv.insert(bv.begin() + 77, src, src + 5);
+	ref.insert(ref.begin() + 77, src, src + 5);
+	bv[3] = !bv[3];
+	ref[3] = !ref[3];
+	bv.resize(5000, true);
+	ref.resize(5000, true);
+	bv.pop_back();
+	ref.pop_back();
+	return same(bv, ref);
+}
+
+// 按字处理的算法
+void test_algo() {
+	BitVector bv(1000, false);
+	stl::fill(bv.begin() + 3, bv.begin() + 700, true);
+	bv[900] = true;
+	std::cout << "count: " << stl::count(bv.begin(), bv.end(), true) << ' '
+		<< stl::count(bv.begin() + 5, bv.begin() + 70, false) << std::endl;
+	std::cout << "find: " << (stl::find(bv.begin(), bv.end(), true) - bv.begin()) << ' '
+		<< (stl::find(bv.begin() + 3, bv.end(), false) - bv.begin()) << ' '
+		<< (stl::find(bv.begin() + 701, bv.end(), true) - bv.begin()) << ' '
+		<< (stl::find(bv.begin() + 901, bv.end(), true) - bv.begin()) << std::endl;
+	stl::fill_n(bv.begin() + 64, 128, false);
+	std::cout << "fill_n: " << stl::count(bv.begin(), bv.end(), true) << std::endl;
+
+	BitVector copy(bv);
+	copy.flip();
+	copy &= bv;
+	std::cout << "flip and: " << stl::count(copy.begin(), copy.end(), true) << ' ' << (copy == bv) << std::endl;
+
+	// 有序区间的集合算法
+	BitVector a(100, false);
+	BitVector b(100, false);
+	stl::fill(a.begin() + 40, a.end(), true);
+	stl::fill(b.begin() + 70, b.end(), true);
+	BitVector u(200);
+	auto e = stl::set_union(a.begin(), a.end(), b.begin(), b.end(), u.begin());
+	std::cout << "union: " << (e - u.begin()) << ' ' << stl::count(u.begin(), e, true);
+	e = stl::set_intersection(a.begin(), a.end(), b.begin(), b.end(), u.begin());
+	std::cout << " intersection: " << (e - u.begin()) << ' ' << stl::count(u.begin(), e, true);
+	std::vector<bool> d;
+	stl::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(d));
+	std::cout << " difference: " << d.size() << ' ' << std::count(d.begin(), d.end(), true);
+	std::cout << " include: " << stl::include(a.begin(), a.end(), b.begin(), b.end()) << std::endl;
+}
+
+void test_scan() {
+	const size_t n = 64 * 1024 * 1024;
+	BitVector bv(n, false);
+	bv[n - 3] = true;
+	auto start = std::chrono::steady_clock::now();
+	auto it = stl::find(bv.begin(), bv.end(), true);
+	auto ones = stl::count(bv.begin(), bv.end(), true);
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "scan: " << (it - bv.begin()) << ' ' << ones << ' ' << bv.capacity() / 8 << " bytes" << std::endl;
+	std::cerr << "find/count: "
+		<< std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+}
+
+int main() {
+	std::cout << "ops: " << (test_ops() ? "ok" : "failed") << std::endl;
+	test_algo();
+	test_scan();
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <string>
+#include <deque>
+
+#include "circular_buffer.hpp"
+#include "queue.hpp"
+#include "arena.hpp"
+
+#include "test_util.hpp"
+
+// 与std::deque对照两端的增删
+template <typename T, typename G>
+bool test_ops(G gen) {
+	stl::CircularBuffer<T> buf(100);
+	std::deque<T> ref;
+	unsigned seed = 3;
+	bool ok = buf.capacity() == 128;
+	for(int i = 0;i < 5000;++i) {
+		seed = seed * 1103515245 + 12345;
+		switch((seed >> 16) % 4) {
+		case 0:
+			ok = ok && buf.try_push_back(gen(i)) == (ref.size() < 128);
+			if(ref.size() < 128) {
+				ref.push_back(gen(i));
+			}
+			break;
+		case 1:
+			if(!buf.full()) {
+				buf.push_front(gen(i));
+				ref.push_front(gen(i));
+			}
+			break;
+		case 2:
+			if(!ref.empty()) {
+				buf.pop_front();
+				ref.pop_front();
+			}
+			break;
+		default:
+			if(!ref.empty()) {
+				buf.pop_back();
+				ref.pop_back();
+			}
+			break;
+		}
+		ok = ok && same(buf, ref) && (ref.empty() || (buf.front() == ref.front() && buf.back() == ref.back()));
+	}
+	stl::CircularBuffer<T> copy(buf);
+	stl::CircularBuffer<T> moved(std::move(copy));
+	copy = moved;
+	ok = ok && copy == buf && moved == buf && copy.capacity() == 128;
+	ok = ok && (buf.empty() || (buf[ref.size() / 2] == ref[ref.size() / 2] &&
+		*(buf.rbegin()) == ref.back() && size_t(buf.end() - buf.begin()) == ref.size()));
+	return ok;
+}
+
+// 作为Queue的底层容器，滑动窗口求和
+void test_queue() {
+	stl::Queue<int, stl::CircularBuffer<int>> window(stl::CircularBuffer<int>(8));
+	long sum = 0;
+	for(int i = 1;i <= 100;++i) {
+		if(window.size() == 8) {
+			sum -= window.front();
+			window.pop();
+		}
+		window.push(i);
+		sum += i;
+	}
+	std::cout << "window: " << window.size() << ' ' << window.front() << ' ' << window.back() << ' ' << sum << std::endl;
+}
+
+// 配置器随构造、复制与交换传递
+bool test_allocator() {
+	stl::Arena arena, other;
+	using buffer_type = stl::CircularBuffer<int, stl::ArenaAllocator<int>>;
+	buffer_type a{stl::ArenaAllocator<int>(arena)};
+	buffer_type b(8, stl::ArenaAllocator<int>(other));
+	for(int i = 0;i < 8;++i) {
+		b.push_back(i);
+	}
+	bool ok = a.capacity() == 0 && a.get_allocator().arena() == &arena && b.get_allocator().arena() == &other;
+
+	buffer_type copy(b);
+	ok = ok && copy == b && copy.get_allocator().arena() == &other && copy.full() && copy.back() == 7;
+	a = copy;
+	ok = ok && a == b && a.get_allocator().arena() == &other;
+	a.swap(copy);
+	return ok && a == b && copy == b;
+}
+
+int main() {
+	std::cout << "int: " << (test_ops<int>([](int i) { return i; }) ? "ok" : "failed") << std::endl;
+	std::cout << "string: " << (test_ops<std::string>([](int i) {
+		return std::string(40, 'a' + (i % 26)) + std::to_string(i);
+	}) ? "ok" : "failed") << std::endl;
+	test_queue();
+	std::cout << "allocator: " << (test_allocator() ? "ok" : "failed") << std::endl;
+	return 0;
+}
@@ -1,7 +1,15 @@
 #include <iostream>
 
+#include <stdint.h>
+
 #include "deque.hpp"
 #include "numeric.hpp"
+#include "aligned_allocator.hpp"
+#include "algorithm.hpp"
+#include "vector.hpp"
+#include "queue.hpp"
+
+#include "test_util.hpp"
 
 class Test {
 	int n;
@@ -224,8 +232,196 @@ void main_test() {
 	std::cout << std::endl;
 }
 
+size_t allocations = 0;
+
+template <typename T>
+struct CountingAllocator :stl::Allocator<T> {
+	template <typename U>
+	struct rebind {
+		using other = CountingAllocator<U>;
+	};
+
+	CountingAllocator() = default;
+
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U> &) {
+	}
+
+	T *allocate(size_t n, const void *p = nullptr) {
+		++allocations;
+		return stl::Allocator<T>::allocate(n, p);
+	}
+};
+
+// 先进先出时复用腾空的缓冲区，缓冲区按配置器对齐
+void test_recycle() {
+	stl::Deque<int, 0, CountingAllocator<int>> fifo;
+	int in = 0, out = 0;
+	bool ok = true;
+	for(int round = 0;round < 10000;++round) {
+		for(int i = 0;i < 3;++i) {
+			fifo.push_back(in++);
+		}
+		for(int i = 0;i < 3;++i) {
+			ok = ok && fifo.front() == out++;
+			fifo.pop_front();
+		}
+	}
+	std::cout << "fifo: " << (ok ? "ok" : "failed") << " buffer size: " << fifo.buffer_size()
+		<< " allocations: " << allocations << std::endl;
+
+	stl::Deque<int, 0, stl::AlignedAllocator<int, 4096>> paged;
+	for(int i = 0;i < 5000;++i) {
+		paged.push_front(i);
+	}
+	// 跨越缓冲区边界处，下一个元素位于页首
+	bool aligned = true;
+	for(size_t i = 1;i < paged.size();++i) {
+		if(&paged[i] != &paged[i - 1] + 1) {
+			aligned = aligned && reinterpret_cast<uintptr_t>(&paged[i]) % 4096 == 0;
+		}
+	}
+	std::cout << "paged buffer size: " << paged.buffer_size() << " aligned: " << aligned
+		<< " sum: " << stl::accumulate(paged.begin(), paged.end(), 0) << std::endl;
+}
+
+struct Sum {
+	long sum;
+
+	void operator()(int x) {
+		sum += x;
+	}
+};
+
+// 分段迭代器上的算法逐段执行，结果与逐元素遍历一致
+void test_segmented() {
+	const int n = 10000;
+	stl::Deque<int> dq(n);
+	stl::Vector<int> ref(size_t(n), 0);
+	stl::iota(dq.begin(), dq.end(), 0);
+	stl::iota(ref.begin(), ref.end(), 0);
+	bool ok = true;
+	unsigned seed = 11;
+	for(int round = 0;round < 200;++round) {
+		seed = seed * 1103515245 + 12345;
+		int a = (seed >> 8) % n;
+		seed = seed * 1103515245 + 12345;
+		int b = a + (seed >> 8) % (n - a + 1);
+		int v = round * 3 % 97;
+		switch(round % 6) {
+		case 0:
+			stl::fill(dq.begin() + a, dq.begin() + b, v);
+			stl::fill(ref.begin() + a, ref.begin() + b, v);
+			break;
+		case 1:
+			stl::fill_n(dq.begin() + a, b - a, v);
+			stl::fill_n(ref.begin() + a, b - a, v);
+			break;
+		case 2:
+			// 区间重叠且向前复制
+			stl::copy(dq.begin() + b - (b - a) / 2, dq.begin() + b, dq.begin() + a);
+			stl::copy(ref.begin() + b - (b - a) / 2, ref.begin() + b, ref.begin() + a);
+			break;
+		case 3:
+			stl::copy(ref.begin() + a, ref.begin() + b, dq.begin() + (n - (b - a)));
+			stl::copy(ref.begin() + a, ref.begin() + b, ref.begin() + (n - (b - a)));
+			break;
+		case 4: {
+			stl::Vector<int> out(size_t(b - a), 0);
+			ok = ok && stl::copy(dq.begin() + a, dq.begin() + b, out.begin()) == out.end();
+			ok = ok && stl::equal(out.begin(), out.end(), ref.begin() + a);
+			break;
+		}
+		default:
+			stl::iota(dq.begin() + a, dq.begin() + b, v);
+			stl::iota(ref.begin() + a, ref.begin() + b, v);
+			break;
+		}
+		ok = ok && (stl::find(dq.begin() + a, dq.begin() + b, v) - dq.begin()) ==
+			(stl::find(ref.begin() + a, ref.begin() + b, v) - ref.begin());
+		ok = ok && (stl::find_if(dq.begin(), dq.begin() + b, [v](int x) { return x > v; }) - dq.begin()) ==
+			(stl::find_if(ref.begin(), ref.begin() + b, [v](int x) { return x > v; }) - ref.begin());
+		ok = ok && stl::count(dq.begin() + a, dq.end(), v) == stl::count(ref.begin() + a, ref.end(), v);
+		ok = ok && stl::for_each(dq.begin(), dq.begin() + b, Sum{ 0 }).sum == stl::for_each(ref.begin(), ref.begin() + b, Sum{ 0 }).sum;
+		ok = ok && stl::accumulate(dq.begin() + a, dq.end(), 0L) == stl::accumulate(ref.begin() + a, ref.end(), 0L);
+	}
+	ok = ok && same(dq, ref);
+
+	stl::Deque<char> text(1500, 'a');
+	stl::fill(text.begin() + 100, text.begin() + 1400, 'b');
+	std::cout << "segmented: " << (ok ? "ok" : "failed") << " chars: " << stl::count(text.begin(), text.end(), 'b')
+		<< ' ' << (stl::find(text.begin(), text.end(), 'b') - text.begin()) << std::endl;
+}
+
+// 预留空间与整段构造，映射表与缓冲区一次分配到位
+void test_bulk() {
+	const size_t n = 1000000;
+	allocations = 0;
+	stl::Deque<int, 0, CountingAllocator<int>> dq;
+	dq.reserve_back(n);
+	size_t reserved = allocations;
+	for(size_t i = 0;i < n;++i) {
+		dq.push_back(int(i));
+	}
+	std::cout << "reserve_back: " << reserved << ' ' << allocations - reserved << std::endl;
+
+	stl::Vector<int> src(size_t(3000), 7);
+	stl::iota(src.begin(), src.end(), 0);
+	allocations = 0;
+	stl::Deque<int, 0, CountingAllocator<int>> loaded;
+	loaded.assign(src.begin(), src.end());
+	loaded.insert(loaded.begin(), src.begin(), src.begin() + 500);
+	loaded.insert(loaded.end(), src.begin() + 500, src.end());
+	loaded.reserve_front(1000);
+	size_t before = allocations;
+	for(int i = 0;i < 1000;++i) {
+		loaded.push_front(i);
+	}
+	std::cout << "bulk: " << loaded.size() << ' ' << loaded[1000] << ' ' << loaded[1500] << ' ' << loaded.back()
+		<< " allocations: " << before << ' ' << allocations - before << std::endl;
+
+	loaded.assign(5, loaded[1500]);
+	std::cout << "assign: " << loaded.size() << ' ' << loaded.front() << ' ' << loaded.back() << std::endl;
+
+	// 整数实参按元素数与初值处理
+	stl::Deque<int> filled(3, 7);
+	filled.assign(4, 9);
+	std::cout << "fill: " << filled.size() << ' ' << filled.front() << ' ' << filled.back() << std::endl;
+}
+
+// 空区间构造、复制空Deque与默认构造Queue，存储预先填充非零字节
+void test_empty() {
+	alignas(stl::Deque<int>) unsigned char raw[sizeof(stl::Deque<int>)];
+	alignas(stl::Queue<int>) unsigned char qraw[sizeof(stl::Queue<int>)];
+	stl::Vector<int> v;
+
+	::memset(raw, 0x5a, sizeof(raw));
+	auto range = new(raw) stl::Deque<int>(v.begin(), v.end());
+	std::cout << "empty range: " << range->size() << ' ' << range->empty();
+	range->~Deque();
+
+	stl::Deque<int> empty;
+	::memset(raw, 0x5a, sizeof(raw));
+	auto copy = new(raw) stl::Deque<int>(empty);
+	copy->push_back(1);
+	std::cout << " copy: " << copy->size();
+	*copy = empty;
+	std::cout << ' ' << copy->size();
+	copy->~Deque();
+
+	::memset(qraw, 0x5a, sizeof(qraw));
+	auto queue = new(qraw) stl::Queue<int>();
+	queue->push(2);
+	std::cout << " queue: " << queue->size() << ' ' << queue->front() << std::endl;
+	queue->~Queue();
+}
+
 int main() {
 	main_test();
+	test_empty();
+	test_recycle();
+	test_segmented();
+	test_bulk();
 	Test::print_static();
 	return 0;
 }
\ No newline at end of file
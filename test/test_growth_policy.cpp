@@ -0,0 +1,40 @@
+#include <iostream>
+
+#include "vector.hpp"
+#include "growth_policy.hpp"
+
+// 逐个追加元素，输出容量变化的序列
+template <typename GROWTH, typename T>
+void print_growth(const char *name, size_t n) {
+	stl::Vector<T, stl::Allocator<T>, GROWTH> vec;
+	size_t cap = vec.capacity();
+	std::cout << name << ':';
+	for(size_t i = 0;i < n;++i) {
+		vec.push_back(T());
+		if(vec.capacity() != cap) {
+			cap = vec.capacity();
+			std::cout << ' ' << cap;
+		}
+	}
+	std::cout << std::endl;
+}
+
+int main() {
+	print_growth<stl::DoubleGrowth, int>("double", 100);
+	print_growth<stl::OneAndHalfGrowth, int>("one and half", 100);
+	print_growth<stl::ChunkedGrowth<64>, int>("chunked", 100);
+
+	// 扩容策略不影响元素
+	stl::Vector<int, stl::Allocator<int>, stl::ChunkedGrowth<1024>> vec;
+	long long sum = 0;
+	for(int i = 0;i < 100000;++i) {
+		vec.push_back(i);
+		sum += i;
+	}
+	vec.insert(vec.begin() + 10, size_t(1000), 1);
+	for(auto i : vec) {
+		sum -= i;
+	}
+	std::cout << "chunked: " << vec.size() << ' ' << vec.capacity() << ' ' << sum << std::endl;
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+
+#include "memory_resource.hpp"
+#include "vector.hpp"
+#include "list.hpp"
+#include "deque.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "unordered_map.hpp"
+
+using PmrVector = stl::Vector<int, stl::PolymorphicAllocator<int>>;
+using PmrList = stl::List<int, stl::PolymorphicAllocator<int>>;
+using PmrDeque = stl::Deque<int, 0, stl::PolymorphicAllocator<int>>;
+using PmrMap = stl::Map<int, int, stl::less<int>,
+	stl::PolymorphicAllocator<stl::Pair<const int, int>>>;
+using PmrSet = stl::Set<int, stl::less<const int>, stl::PolymorphicAllocator<int>>;
+using PmrUnorderedMap = stl::UnorderedMap<int, int, stl::stlHash<int>, stl::equal_to<int>,
+	stl::PolymorphicAllocator<stl::Pair<const int, int>>>;
+
+// 统计分配次数的内存资源
+class CountingResource :public stl::MemoryResource {
+public:
+	size_type allocated = 0;
+	size_type deallocated = 0;
+protected:
+	void *do_allocate(size_type n, size_type align) override {
+		++allocated;
+		return stl::new_delete_resource()->allocate(n, align);
+	}
+
+	void do_deallocate(void *p, size_type n, size_type align) override {
+		++deallocated;
+		stl::new_delete_resource()->deallocate(p, n, align);
+	}
+};
+
+// 同一类型的容器可来自不同的内存资源
+long long sum_map(const PmrMap &map_) {
+	long long sum = 0;
+	for(auto &p : map_) {
+		sum += p.second;
+	}
+	return sum;
+}
+
+void fill(PmrVector &vec, PmrList &list0, PmrDeque &deque0, PmrMap &map0,
+	PmrSet &set0, PmrUnorderedMap &umap0) {
+	for(int i = 0;i < 1000;++i) {
+		vec.push_back(i);
+		list0.push_back(i);
+		deque0.push_back(i);
+		map0[i] = i;
+		set0.insert(i);
+		umap0.emplace(i, i);
+	}
+}
+
+void test_resource(stl::MemoryResource *resource, const char *name) {
+	stl::PolymorphicAllocator<int> alloc(resource);
+	PmrVector vec(alloc);
+	PmrList list0(alloc);
+	PmrDeque deque0(alloc);
+	PmrMap map0(alloc);
+	PmrSet set0(alloc);
+	PmrUnorderedMap umap0(alloc);
+	fill(vec, list0, deque0, map0, set0, umap0);
+
+	// 移动后的容器仍使用原内存资源
+	PmrMap map1(std::move(map0));
+	PmrVector vec1(std::move(vec));
+	PmrUnorderedMap umap1(std::move(umap0));
+	std::cout << name << ": " << sum_map(map1) << ' ' << vec1.size() << ' '
+		<< list0.size() << ' ' << deque0.size() << ' ' << set0.size() << ' ' << umap1.size() << ' '
+		<< (vec1.get_allocator().resource() == resource ? "same resource" : "wrong resource")
+		<< std::endl;
+}
+
+void test_swap() {
+	CountingResource a, b;
+	{
+		stl::PolymorphicAllocator<int> alloc_a(&a), alloc_b(&b);
+		PmrMap map0(alloc_a);
+		PmrMap map1(alloc_b);
+		for(int i = 0;i < 100;++i) {
+			map0[i] = i;
+			map1[-i] = i;
+		}
+		map0.swap(map1);
+		map0 = std::move(map1);
+	}
+	std::cout << "swap: " << (a.allocated == a.deallocated && b.allocated == b.deallocated ?
+		"balanced" : "unbalanced") << std::endl;
+}
+
+int main() {
+	stl::PoolResource pool;
+	stl::MonotonicResource monotonic;
+	CountingResource counting;
+
+	test_resource(stl::new_delete_resource(), "new_delete");
+	test_resource(&pool, "pool");
+	test_resource(&monotonic, "monotonic");
+	test_resource(&counting, "counting");
+	std::cout << "counting balanced: " << (counting.allocated == counting.deallocated ? "yes" : "no")
+		<< std::endl;
+
+	test_swap();
+
+	stl::MemoryResource *prev = stl::set_default_resource(&pool);
+	PmrList list0;
+	list0.push_back(1);
+	std::cout << "default: " << (list0.front() == 1 ? "ok" : "failed") << std::endl;
+	stl::set_default_resource(prev);
+	return 0;
+}
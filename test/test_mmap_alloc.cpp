@@ -0,0 +1,63 @@
+#define _TINY_STL_MMAP_ALLOC_
+
+#include <iostream>
+
+#include "mmap_alloc.hpp"
+#include "vector.hpp"
+#include "deque.hpp"
+
+void test_alloc() {
+	stl::MmapAlloc alloc;
+	size_t n = 4 * stl::MmapAlloc::huge_page_size;
+	char *p = static_cast<char *>(alloc.allocate(n));
+	std::cout << "huge page aligned: "
+		<< (reinterpret_cast<uintptr_t>(p) % stl::MmapAlloc::huge_page_size == 0 ? "yes" : "no")
+		<< std::endl;
+	for(size_t i = 0;i < n;i += 4096) {
+		p[i] = static_cast<char>(i >> 12);
+	}
+
+	p = static_cast<char *>(alloc.reallocate(p, n, 2 * n));
+	bool ok = p != nullptr;
+	for(size_t i = 0;ok && i < n;i += 4096) {
+		ok = p[i] == static_cast<char>(i >> 12);
+	}
+	std::cout << "mremap keeps content: " << (ok ? "yes" : "no") << std::endl;
+	alloc.deallocate(p, 2 * n);
+}
+
+void test_vector() {
+	stl::Vector<uint64_t> vec;
+	for(uint64_t i = 0;i < 4 * 1024 * 1024;++i) {
+		vec.push_back(i);
+	}
+	bool ok = true;
+	for(uint64_t i = 0;i < vec.size();++i) {
+		if(vec[i] != i) {
+			ok = false;
+			break;
+		}
+	}
+	std::cout << "vector size: " << vec.size() << " capacity: " << vec.capacity()
+		<< " content: " << (ok ? "ok" : "broken") << std::endl;
+
+	vec.resize(6 * 1024 * 1024, 1);
+	vec.reserve(16 * 1024 * 1024);
+	std::cout << "after reserve: " << vec[4 * 1024 * 1024 - 1] << ' ' << vec.back()
+		<< " capacity: " << vec.capacity() << std::endl;
+}
+
+void test_deque() {
+	stl::Deque<uint64_t> deque0;
+	for(uint64_t i = 0;i < 1024 * 1024;++i) {
+		deque0.push_back(i);
+	}
+	std::cout << "deque back: " << deque0.back() << std::endl;
+}
+
+int main() {
+	test_alloc();
+	test_vector();
+	test_deque();
+	return 0;
+}
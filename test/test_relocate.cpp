@@ -0,0 +1,309 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <stdexcept>
+
+#include "vector.hpp"
+#include "deque.hpp"
+#include "small_vector.hpp"
+#include "static_vector.hpp"
+
+#include "test_util.hpp"
+
+// 持有堆内存的句柄，可按位搬移但移动构造与析构并非平凡
+struct Handle {
+	static int moved;
+	int *m_value_;
+
+	Handle(int v = 0) :m_value_(new int(v)) {
+	}
+
+	Handle(const Handle &h) :m_value_(new int(*h.m_value_)) {
+	}
+
+	Handle(Handle &&h) :m_value_(h.m_value_) {
+		h.m_value_ = nullptr;
+		++moved;
+	}
+
+	Handle &operator=(const Handle &h) {
+		if(this != &h) {
+			delete m_value_;
+			m_value_ = new int(*h.m_value_);
+		}
+		return *this;
+	}
+
+	Handle &operator=(Handle &&h) {
+		std::swap(m_value_, h.m_value_);
+		++moved;
+		return *this;
+	}
+
+	~Handle() {
+		delete m_value_;
+	}
+
+	int value() const {
+		return *m_value_;
+	}
+};
+
+int Handle::moved = 0;
+
+bool operator!=(const Handle &h, int v) {
+	return h.value() != v;
+}
+
+namespace stl {
+
+template<>
+struct is_trivially_relocatable<Handle> {
+	using type = true_type;
+}; // struct is_trivially_relocatable<Handle>
+
+} // namespace stl
+
+// 移动构造可能抛出异常，复制构造在计数归零时抛出异常
+struct Fragile {
+	static int copies;
+	static int moves;
+	static int copy_budget;
+	int m_value_;
+
+	Fragile(int v = 0) :m_value_(v) {
+	}
+
+	Fragile(const Fragile &f) :m_value_(f.m_value_) {
+		if(copy_budget-- == 0) {
+			throw std::runtime_error("copy failed");
+		}
+		++copies;
+	}
+
+	Fragile(Fragile &&f) :m_value_(f.m_value_) {
+		f.m_value_ = -1;
+		++moves;
+	}
+
+	~Fragile() {
+	}
+};
+
+int Fragile::copies = 0;
+int Fragile::moves = 0;
+int Fragile::copy_budget = -1;
+
+// 移动构造不抛出异常
+struct Sturdy {
+	static int copies;
+	static int moves;
+	int m_value_;
+
+	Sturdy(int v = 0) :m_value_(v) {
+	}
+
+	Sturdy(const Sturdy &s) :m_value_(s.m_value_) {
+		++copies;
+	}
+
+	Sturdy(Sturdy &&s) noexcept :m_value_(s.m_value_) {
+		++moves;
+	}
+
+	~Sturdy() {
+	}
+};
+
+int Sturdy::copies = 0;
+int Sturdy::moves = 0;
+
+// 扩容失败时原有元素保持不变，移动构造不抛出异常时不复制
+void test_strong_guarantee() {
+	stl::Vector<Fragile> vec;
+	for(int i = 0;i < 100;++i) {
+		vec.emplace_back(i);
+	}
+	Fragile::copies = 0;
+	Fragile::moves = 0;
+	Fragile::copy_budget = 50;
+	bool thrown = false;
+	try {
+		vec.reserve(1000);
+	} catch(const std::runtime_error &) {
+		thrown = true;
+	}
+	Fragile::copy_budget = -1;
+	bool intact = vec.size() == 100 && vec.capacity() < 1000;
+	for(int i = 0;i < 100;++i) {
+		intact = intact && vec[i].m_value_ == i;
+	}
+	std::cout << "fragile: thrown " << thrown << " intact " << intact
+		<< " moves " << Fragile::moves << std::endl;
+
+	stl::Vector<Sturdy> sturdy;
+	for(int i = 0;i < 1000;++i) {
+		sturdy.emplace_back(i);
+	}
+	std::cout << "sturdy copies: " << Sturdy::copies << std::endl;
+}
+
+// 嵌套容器扩容时按位搬移，内层数据不被复制
+void test_nested() {
+	stl::Vector<stl::Vector<int>> outer;
+	outer.emplace_back(size_t(100), 1);
+	const int *inner = outer[0].data();
+	for(int i = 0;i < 1000;++i) {
+		outer.emplace_back(size_t(10), i);
+	}
+	outer.insert(outer.begin(), stl::Vector<int>(size_t(5), 7));
+	std::cout << "nested: " << (outer[1].data() == inner ? "relocated" : "copied")
+		<< ' ' << outer.size() << ' ' << outer[1].size() << ' ' << outer[0][4] << std::endl;
+}
+
+// 可按位搬移，构造在计数归零时抛出异常
+struct Brittle {
+	static int budget;
+	int m_value_;
+
+	Brittle(int v = 0) :m_value_(v) {
+		spend();
+	}
+
+	Brittle(const Brittle &b) :m_value_(b.m_value_) {
+		spend();
+	}
+
+	Brittle(Brittle &&b) :m_value_(b.m_value_) {
+		spend();
+	}
+
+	Brittle &operator=(const Brittle &b) = default;
+
+	static void spend() {
+		if(budget-- == 0) {
+			throw std::runtime_error("construct failed");
+		}
+	}
+};
+
+int Brittle::budget = -1;
+
+namespace stl {
+
+template<>
+struct is_trivially_relocatable<Brittle> {
+	using type = true_type;
+}; // struct is_trivially_relocatable<Brittle>
+
+} // namespace stl
+
+// 插入时构造新元素抛出异常，已搬移的元素移回原处，容器保持不变
+template <typename C>
+bool test_insert_rollback() {
+	C c;
+	for(int i = 0;i < 10;++i) {
+		c.emplace_back(i);
+	}
+	const int src[3] = { 100, 101, 102 };
+	int thrown = 0;
+	// 分别在靠近尾部与靠近头部的位置插入
+	for(int pos : { 8, 2 }) {
+		try {
+			Brittle::budget = 1;
+			c.insert(c.begin() + pos, src, src + 3);
+		} catch(const std::runtime_error &) {
+			++thrown;
+		}
+		try {
+			Brittle x(-1);
+			Brittle::budget = 2;
+			c.insert(c.begin() + pos, 3, x);
+		} catch(const std::runtime_error &) {
+			++thrown;
+		}
+		try {
+			Brittle x(-1);
+			Brittle::budget = 0;
+			c.insert(c.begin() + pos, std::move(x));
+		} catch(const std::runtime_error &) {
+			++thrown;
+		}
+	}
+	Brittle::budget = -1;
+	bool ok = thrown == 6 && c.size() == 10;
+	for(int i = 0;ok && i < 10;++i) {
+		ok = c[i].m_value_ == i;
+	}
+	return ok;
+}
+
+template <typename C>
+bool test_container() {
+	C c;
+	std::vector<int> r;
+	for(int i = 0;i < 1000;++i) {
+		c.push_back(Handle(i));
+		r.push_back(i);
+	}
+	// 中部插入与删除，覆盖靠近两端的位置
+	for(int i = 0;i < 200;++i) {
+		size_t pos = (i * 37) % r.size();
+		c.insert(c.begin() + pos, Handle(-i));
+		r.insert(r.begin() + pos, -i);
+		c.insert(c.begin() + pos, 3, Handle(i));
+		r.insert(r.begin() + pos, 3, i);
+		c.insert(c.begin() + pos, c[pos + 1]);
+		r.insert(r.begin() + pos, r[pos + 1]);
+	}
+	for(int i = 0;i < 300;++i) {
+		size_t pos = (i * 53) % (r.size() - 4);
+		auto it = c.erase(c.begin() + pos, c.begin() + pos + 3);
+		r.erase(r.begin() + pos, r.begin() + pos + 3);
+		if(it != c.end() && it->value() != r[pos]) {
+			return false;
+		}
+	}
+	Handle src[5] = { 10, 20, 30, 40, 50 };
+	c.insert(c.begin() + 7, src, src + 5);
+	int ref[5] = { 10, 20, 30, 40, 50 };
+	r.insert(r.begin() + 7, ref, ref + 5);
+	return same(c, r);
+}
+
+int main() {
+	Handle::moved = 0;
+	bool ok = test_container<stl::Vector<Handle>>();
+	std::cout << "vector: " << (ok ? "ok" : "failed") << std::endl;
+	std::cout << "vector moves: " << Handle::moved << std::endl;
+
+	Handle::moved = 0;
+	ok = test_container<stl::Deque<Handle>>();
+	std::cout << "deque: " << (ok ? "ok" : "failed") << std::endl;
+	std::cout << "deque moves: " << Handle::moved << std::endl;
+
+	stl::Deque<Handle, 4> small;
+	std::deque<int> r;
+	for(int i = 0;i < 64;++i) {
+		small.push_back(Handle(i));
+		r.push_back(i);
+	}
+	small.insert(small.begin() + 10, 9, Handle(7));
+	r.insert(r.begin() + 10, 9, 7);
+	small.insert(small.begin() + 50, 11, Handle(8));
+	r.insert(r.begin() + 50, 11, 8);
+	small.erase(small.begin() + 3, small.begin() + 14);
+	r.erase(r.begin() + 3, r.begin() + 14);
+	small.erase(small.begin() + 40, small.begin() + 53);
+	r.erase(r.begin() + 40, r.begin() + 53);
+	std::cout << "deque<4>: " << (same(small, r) ? "ok" : "failed") << std::endl;
+
+	test_strong_guarantee();
+	test_nested();
+	std::cout << "insert rollback: vector " << (test_insert_rollback<stl::Vector<Brittle>>() ? "ok" : "failed")
+		<< " deque " << (test_insert_rollback<stl::Deque<Brittle>>() ? "ok" : "failed")
+		<< " deque<4> " << (test_insert_rollback<stl::Deque<Brittle, 4>>() ? "ok" : "failed")
+		<< " small " << (test_insert_rollback<stl::SmallVector<Brittle, 16>>() ? "ok" : "failed")
+		<< " static " << (test_insert_rollback<stl::StaticVector<Brittle, 16>>() ? "ok" : "failed") << std::endl;
+	return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "deque.hpp"
+#include "vector.hpp"
+#include "scatter_io.hpp"
+
+// Deque作为发送缓冲区，经管道聚集写出后分散读入Vector与Deque
+void test_pipe() {
+	int fds[2];
+	if(::pipe(fds) != 0) {
+		std::cout << "pipe failed" << std::endl;
+		return;
+	}
+	::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+	stl::Deque<char> send;
+	std::string text;
+	for(int i = 0;i < 600;++i) {
+		text += "line " + std::to_string(i) + "\n";
+	}
+	send.assign(text.data(), text.data() + text.size());
+
+	stl::iovec_buffer iov(stl::iovec_count(send.begin(), send.end(), stl::tinystl_iov_max));
+	size_t blocks = stl::make_iovec(send.begin(), send.end(), iov.begin(), iov.size());
+	size_t bytes = 0;
+	for(size_t i = 0;i < blocks;++i) {
+		bytes += iov[i].iov_len;
+	}
+	std::cout << "iovec: " << blocks << ' ' << bytes << ' ' << text.size() << std::endl;
+
+	// 项数不足时只描述区间的前缀
+	size_t prefix = stl::make_iovec(send.begin() + 1, send.end(), iov.begin(), 2);
+	bool contiguous = static_cast<char *>(iov[0].iov_base) == &send[1] &&
+		static_cast<char *>(iov[1].iov_base) == &send[iov[0].iov_len + 1];
+	std::cout << "prefix: " << prefix << ' ' << (iov[0].iov_len + iov[1].iov_len < text.size() - 1)
+		<< ' ' << contiguous << std::endl;
+
+	// 段数超过栈上容量时改在堆上分配
+	stl::Deque<char> large(20000, 'x');
+	stl::iovec_buffer many(stl::iovec_count(large.begin(), large.end(), stl::tinystl_iov_max));
+	size_t segments = stl::make_iovec(large.begin(), large.end(), many.begin(), many.size());
+	size_t total = 0;
+	for(size_t i = 0;i < segments;++i) {
+		total += many[i].iov_len;
+	}
+	std::cout << "large: " << (segments > stl::tinystl_iov_inline) << ' ' << total << std::endl;
+
+	// 先写出一部分，余下的由drain_to写出
+	ssize_t first = stl::write_from(fds[1], send, send.size() - 100);
+	send.erase(send.end() - 100, send.end());
+	ssize_t rest = stl::drain_to(fds[1], send);
+	std::cout << "written: " << first << ' ' << rest << " left: " << send.size() << std::endl;
+
+	stl::Vector<char> head;
+	ssize_t r1 = stl::read_into(fds[0], head, 100);
+	stl::Deque<char> body;
+	ssize_t r2 = stl::read_into(fds[0], body, 100000);
+	ssize_t r3 = stl::read_into(fds[0], body, 10);
+	std::string got(head.data(), head.size());
+	for(size_t i = 0;i < body.size();++i) {
+		got += body[i];
+	}
+	std::string expect = text.substr(text.size() - 100) + text.substr(0, text.size() - 100);
+	std::cout << "read: " << r1 << ' ' << r2 << ' ' << r3 << ' ' << body.size() << ' '
+		<< (got == expect ? "ok" : "failed") << std::endl;
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+int main() {
+	test_pipe();
+	return 0;
+}
@@ -55,7 +55,54 @@ void main_func() {
 	std::cout << std::endl;
 }
 
+// 单遍输入迭代器，所有副本共享同一读取位置，遍历一次后即耗尽
+class SinglePassIterator {
+public:
+	using iterator_category = stl::input_iterator_tag;
+	using value_type = int;
+	using difference_type = ::ptrdiff_t;
+	using pointer = const int *;
+	using reference = const int &;
+private:
+	const int **m_cur_;
+	const int *m_end_;
+public:
+	SinglePassIterator(const int **cur, const int *end) :m_cur_(cur), m_end_(end) {
+	}
+
+	reference operator*() const {
+		return **m_cur_;
+	}
+
+	SinglePassIterator &operator++() {
+		++*m_cur_;
+		return *this;
+	}
+
+	bool operator==(const SinglePassIterator &s) const {
+		return (m_cur_ == nullptr || *m_cur_ == m_end_) == (s.m_cur_ == nullptr || *s.m_cur_ == s.m_end_);
+	}
+
+	bool operator!=(const SinglePassIterator &s) const {
+		return !operator==(s);
+	}
+}; // class SinglePassIterator
+
+void test_input_range() {
+	const int data[] = {5, 3, 9, 3, 1};
+	const int *cur = data;
+	stl::Set<int> set_;
+	set_.insert(SinglePassIterator(&cur, data + 5), SinglePassIterator(nullptr, nullptr));
+	show(set_);
+
+	cur = data;
+	stl::MultiSet<int> multi;
+	multi.insert(SinglePassIterator(&cur, data + 5), SinglePassIterator(nullptr, nullptr));
+	std::cout << "multiset size: " << multi.size() << std::endl;
+}
+
 int main() {
 	main_func();
+	test_input_range();
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <thread>
+
+#include "slab.hpp"
+#include "list.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "unordered_map.hpp"
+
+using SlabList = stl::List<int, stl::SlabAllocator<int>>;
+using SlabMap = stl::Map<int, int, stl::less<int>, stl::SlabAllocator<stl::Pair<const int, int>>>;
+using SlabSet = stl::Set<int, stl::less<const int>, stl::SlabAllocator<int>>;
+using SlabUnorderedMap = stl::UnorderedMap<int, int, stl::stlHash<int>, stl::equal_to<int>,
+	stl::SlabAllocator<stl::Pair<const int, int>>>;
+
+// 批量备好的结点地址连续
+void test_reserve() {
+	using slab = stl::Slab<sizeof(long), alignof(long)>;
+	stl::SlabAllocator<long> alloc;
+	alloc.reserve(64);
+	long *prev = alloc.allocate(1);
+	bool contiguous = true;
+	long *first = prev;
+	for(int i = 1;i < 64;++i) {
+		long *p = alloc.allocate(1);
+		contiguous = contiguous && reinterpret_cast<char *>(p) ==
+			reinterpret_cast<char *>(prev) + slab::object_size;
+		prev = p;
+	}
+	for(int i = 0;i < 64;++i) {
+		alloc.deallocate(reinterpret_cast<long *>(reinterpret_cast<char *>(first) + i * slab::object_size), 1);
+	}
+	std::cout << "reserve contiguous: " << (contiguous ? "yes" : "no") << std::endl;
+}
+
+void test_container() {
+	SlabList list0;
+	SlabMap map0;
+	SlabSet set0;
+	SlabUnorderedMap umap0;
+	for(int i = 0;i < 10000;++i) {
+		list0.push_back(i);
+		map0[i] = i;
+		set0.insert(i);
+		umap0.emplace(i, i);
+	}
+	for(int i = 0;i < 10000;i += 2) {
+		map0.erase(i);
+		list0.pop_front();
+	}
+
+	SlabList list1(list0);
+	SlabMap map1(map0);
+	SlabUnorderedMap umap1(umap0);
+	SlabSet set1;
+	set1.insert(list1.begin(), list1.end());
+
+	long long sum = 0;
+	for(auto &p : map1) {
+		sum += p.second;
+	}
+	for(int i : list1) {
+		sum += i;
+	}
+	std::cout << "size: " << list1.size() << ' ' << map1.size() << ' ' << set1.size() << ' '
+		<< umap1.size() << std::endl;
+	std::cout << "sum: " << sum << std::endl;
+}
+
+// 线程退出后其slab由新线程接管
+void test_thread() {
+	SlabList list0;
+	std::thread producer([&list0]() {
+		SlabList tmp;
+		for(int i = 0;i < 1000;++i) {
+			tmp.push_back(i);
+		}
+		list0 = tmp;
+	});
+	producer.join();
+	std::thread consumer([&list0]() {
+		list0.clear();
+		for(int i = 0;i < 100;++i) {
+			list0.push_back(i);
+		}
+	});
+	consumer.join();
+	long long sum = 0;
+	for(int i : list0) {
+		sum += i;
+	}
+	std::cout << "thread sum: " << sum << std::endl;
+}
+
+int main() {
+	test_reserve();
+	test_container();
+	test_thread();
+	return 0;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "small_vector.hpp"
+
+#include "test_util.hpp"
+
+// 未超出内联容量时不分配堆内存
+void test_inline() {
+	stl::SmallVector<int, 8> vec;
+	for(int i = 0;i < 8;++i) {
+		vec.push_back(i);
+	}
+	std::cout << "inline: " << vec.is_inline() << ' ' << vec.size() << ' ' << vec.capacity() << std::endl;
+	vec.push_back(8);
+	std::cout << "overflow: " << vec.is_inline() << ' ' << vec.size() << ' ' << vec.capacity() << std::endl;
+	vec.resize(3);
+	vec.shrink_to_fit();
+	std::cout << "shrink: " << vec.is_inline() << ' ' << vec.size() << ' ' << vec[2] << std::endl;
+	vec.clear();
+	std::cout << "clear: " << vec.is_inline() << ' ' << vec.empty() << std::endl;
+}
+
+template <typename T, typename G>
+bool test_ops(G gen) {
+	stl::SmallVector<T, 4> vec;
+	std::vector<T> ref;
+	for(int i = 0;i < 100;++i) {
+		size_t pos = (i * 7) % (ref.size() + 1);
+		vec.insert(vec.begin() + pos, gen(i));
+		ref.insert(ref.begin() + pos, gen(i));
+		if(i % 3 == 0) {
+			vec.insert(vec.begin() + pos / 2, size_t(2), gen(-i));
+			ref.insert(ref.begin() + pos / 2, 2, gen(-i));
+		}
+		if(i % 5 == 0 && ref.size() > 1) {
+			vec.insert(vec.begin(), vec[1]);
+			ref.insert(ref.begin(), T(ref[1]));
+		}
+		if(i % 4 == 0) {
+			vec.erase(vec.begin() + pos / 3);
+			ref.erase(ref.begin() + pos / 3);
+		}
+	}
+	T src[3] = { gen(1), gen(2), gen(3) };
+	vec.insert(vec.begin() + 5, src, src + 3);
+	ref.insert(ref.begin() + 5, src, src + 3);
+	vec.erase(vec.begin() + 10, vec.begin() + 30);
+	ref.erase(ref.begin() + 10, ref.begin() + 30);
+	vec.emplace_back(vec[0]);
+	ref.push_back(ref[0]);
+	return same(vec, ref);
+}
+
+// 内联与堆状态之间的移动与交换
+void test_move_swap() {
+	using SV = stl::SmallVector<std::string, 4>;
+	SV a;
+	SV b;
+	for(int i = 0;i < 3;++i) {
+		a.push_back(std::to_string(i));
+	}
+	for(int i = 0;i < 10;++i) {
+		b.push_back(std::string(20, 'a' + i));
+	}
+	const std::string *heap = b.data();
+	a.swap(b);
+	std::cout << "swap: " << a.is_inline() << b.is_inline() << ' ' << (a.data() == heap)
+		<< ' ' << a.size() << ' ' << b.size() << ' ' << a[9] << ' ' << b[2] << std::endl;
+
+	SV c(std::move(a));
+	std::cout << "move heap: " << c.is_inline() << (c.data() == heap) << ' ' << a.empty() << a.is_inline()
+		<< ' ' << c.size() << std::endl;
+	SV d(std::move(b));
+	std::cout << "move inline: " << d.is_inline() << ' ' << b.empty() << ' ' << d[0] << d[1] << d[2] << std::endl;
+
+	stl::swap(c, d);
+	std::cout << "swap mixed: " << c.is_inline() << d.is_inline() << ' ' << c.size() << ' ' << d.size()
+		<< ' ' << c[1] << ' ' << d[0] << std::endl;
+	SV e(c);
+	e = d;
+	d = std::move(c);
+	std::cout << "assign: " << (e == SV(e)) << ' ' << e.size() << ' ' << d.size() << ' ' << c.empty() << std::endl;
+}
+
+int main() {
+	test_inline();
+	std::cout << "int: " << (test_ops<int>([](int i) { return i; }) ? "ok" : "failed") << std::endl;
+	std::cout << "string: " << (test_ops<std::string>([](int i) { return std::to_string(i) +
+		std::string(static_cast<size_t>(i < 0 ? -i : i) % 30, 'x'); }) ? "ok" : "failed") << std::endl;
+	test_move_swap();
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "stable_vector.hpp"
+#include "arena.hpp"
+
+#include "test_util.hpp"
+
+// 扩容后元素地址不变
+bool test_stable() {
+	stl::StableVector<int, 16> vec;
+	std::vector<int *> addr;
+	for(int i = 0;i < 1000;++i) {
+		addr.push_back(&vec.emplace_back(i));
+	}
+	auto it = vec.begin() + 500;
+	for(int i = 0;i < 5000;++i) {
+		vec.push_back(vec[i]);
+	}
+	for(int i = 0;i < 1000;++i) {
+		if(addr[i] != &vec[i] || *addr[i] != i) {
+			return false;
+		}
+	}
+	// 迭代器在索引表扩展后依然有效
+	return *it == 500 && vec.size() == 6000 && vec.capacity() == 6000;
+}
+
+template <typename T, typename G>
+bool test_ops(G gen) {
+	stl::StableVector<T, 8> vec;
+	std::vector<T> ref;
+	for(int i = 0;i < 300;++i) {
+		vec.push_back(gen(i));
+		ref.push_back(gen(i));
+		if(i % 7 == 0) {
+			vec.pop_back();
+			ref.pop_back();
+		}
+	}
+	vec.resize(350, gen(-1));
+	ref.resize(350, gen(-1));
+	vec.resize(123);
+	ref.resize(123);
+	vec.shrink_to_fit();
+	stl::StableVector<T, 8> copy(vec);
+	stl::StableVector<T, 8> moved(std::move(copy));
+	copy = moved;
+	bool ok = same(vec, ref) && copy == vec && moved == vec && copy.size() == 123 && vec.capacity() == 128;
+	ok = ok && vec.front() == ref.front() && vec.back() == ref.back() && vec.at(77) == ref[77];
+	ok = ok && vec.end() - vec.begin() == 123 && *(vec.rbegin() + 3) == ref[119];
+	return ok;
+}
+
+// 按段遍历
+void test_segments() {
+	stl::StableVector<long> vec;
+	for(long i = 0;i < 1000;++i) {
+		vec.push_back(i);
+	}
+	long sum = 0;
+	vec.for_each_segment([&sum](const long *first, const long *last) {
+		for(;first != last;++first) {
+			sum += *first;
+		}
+	});
+	std::cout << "block size: " << stl::StableVector<long>::block_size << " segments: " << vec.segment_count()
+		<< " last segment: " << vec.segment_size(vec.segment_count() - 1) << " sum: " << sum << std::endl;
+}
+
+// 交换与移动后迭代器随元素转移，配置器随之传递
+bool test_transfer() {
+	stl::Arena arena, other;
+	using vector_type = stl::StableVector<int, 8, stl::ArenaAllocator<int>>;
+	vector_type a{stl::ArenaAllocator<int>(arena)};
+	vector_type b{stl::ArenaAllocator<int>(other)};
+	for(int i = 0;i < 100;++i) {
+		a.push_back(i);
+	}
+	b.push_back(-1);
+	auto ia = a.begin() + 42;
+	auto ib = b.begin();
+	a.swap(b);
+	bool ok = *ia == 42 && *ib == -1 && ia - b.begin() == 42 && ib == a.begin();
+	ok = ok && a.get_allocator().arena() == &other && b.get_allocator().arena() == &arena;
+
+	vector_type moved(std::move(b));
+	for(int i = 0;i < 1000;++i) {
+		moved.push_back(i);
+	}
+	ok = ok && *ia == 42 && ia[57] == 99 && moved.end() - ia == 1058 && b.empty();
+	ok = ok && moved.get_allocator().arena() == &arena;
+
+	vector_type copy(moved);
+	copy = a;
+	ok = ok && copy == a && copy.get_allocator().arena() == &other;
+	moved = std::move(copy);
+	return ok && moved == a && *moved.begin() == -1 && copy.empty();
+}
+
+// 空容器与clear后取得的迭代器在插入元素后依然有效
+bool test_empty_iterator() {
+	stl::StableVector<int, 4> vec;
+	auto it = vec.end();
+	vec.push_back(7);
+	bool ok = *it == 7;
+	for(int i = 0;i < 100;++i) {
+		vec.push_back(i);
+	}
+	ok = ok && *it == 7 && it[100] == 99;
+	vec.clear();
+	auto cit = static_cast<const stl::StableVector<int, 4> &>(vec).begin();
+	vec.push_back(8);
+	return ok && *cit == 8 && cit + 1 == static_cast<const stl::StableVector<int, 4> &>(vec).end();
+}
+
+int main() {
+	std::cout << "stable: " << (test_stable() ? "ok" : "failed") << std::endl;
+	std::cout << "int: " << (test_ops<int>([](int i) { return i; }) ? "ok" : "failed") << std::endl;
+	std::cout << "string: " << (test_ops<std::string>([](int i) {
+		return std::string(40, 'a' + (i % 26)) + std::to_string(i);
+	}) ? "ok" : "failed") << std::endl;
+	test_segments();
+	std::cout << "transfer: " << (test_transfer() ? "ok" : "failed") << std::endl;
+	std::cout << "empty iterator: " << (test_empty_iterator() ? "ok" : "failed") << std::endl;
+	return 0;
+}
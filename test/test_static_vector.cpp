@@ -0,0 +1,77 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "static_vector.hpp"
+
+#include "test_util.hpp"
+
+template <typename T, typename G>
+bool test_ops(G gen) {
+	stl::StaticVector<T, 256> vec;
+	std::vector<T> ref;
+	for(int i = 0;i < 100;++i) {
+		size_t pos = (i * 7) % (ref.size() + 1);
+		vec.insert(vec.begin() + pos, gen(i));
+		ref.insert(ref.begin() + pos, gen(i));
+		if(i % 3 == 0) {
+			vec.insert(vec.begin() + pos / 2, size_t(2), gen(-i));
+			ref.insert(ref.begin() + pos / 2, 2, gen(-i));
+		}
+		if(i % 5 == 0 && ref.size() > 1) {
+			vec.insert(vec.begin(), vec[1]);
+			ref.insert(ref.begin(), T(ref[1]));
+		}
+		if(i % 4 == 0) {
+			vec.erase(vec.begin() + pos / 3);
+			ref.erase(ref.begin() + pos / 3);
+		}
+	}
+	T src[3] = { gen(1), gen(2), gen(3) };
+	vec.insert(vec.begin() + 5, src, src + 3);
+	ref.insert(ref.begin() + 5, src, src + 3);
+	vec.erase(vec.begin() + 10, vec.begin() + 30);
+	ref.erase(ref.begin() + 10, ref.begin() + 30);
+	vec.emplace_back(vec[0]);
+	ref.push_back(ref[0]);
+	vec.resize(50);
+	ref.resize(50);
+	return same(vec, ref);
+}
+
+// 容量用尽时try_push_back失败
+void test_full() {
+	stl::StaticVector<int, 4> vec;
+	int pushed = 0;
+	for(int i = 0;i < 10;++i) {
+		pushed += vec.try_push_back(i);
+	}
+	std::cout << "full: " << vec.full() << ' ' << pushed << ' ' << vec.size() << ' ' << vec.back()
+		<< ' ' << sizeof(vec) << std::endl;
+}
+
+void test_copy_swap() {
+	using SV = stl::StaticVector<std::string, 8>;
+	SV a(size_t(3), std::string("aaaaaaaaaaaaaaaaaaaaaaaa"));
+	SV b;
+	for(int i = 0;i < 6;++i) {
+		b.push_back(std::to_string(i));
+	}
+	a.swap(b);
+	std::cout << "swap: " << a.size() << ' ' << b.size() << ' ' << a[5] << ' ' << b[2].size() << std::endl;
+	SV c(a);
+	SV d(std::move(b));
+	stl::swap(c, d);
+	c = d;
+	d = std::move(a);
+	std::cout << "assign: " << (c == SV(c)) << ' ' << c.size() << ' ' << d.size() << ' ' << d[4] << std::endl;
+}
+
+int main() {
+	std::cout << "int: " << (test_ops<int>([](int i) { return i; }) ? "ok" : "failed") << std::endl;
+	std::cout << "string: " << (test_ops<std::string>([](int i) { return std::to_string(i) +
+		std::string(static_cast<size_t>(i < 0 ? -i : i) % 30, 'x'); }) ? "ok" : "failed") << std::endl;
+	test_full();
+	test_copy_swap();
+	return 0;
+}
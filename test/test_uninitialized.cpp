@@ -0,0 +1,114 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+
+#include "vector.hpp"
+#include "uninitialized.hpp"
+
+// 计算析构次数，检验非平凡类型仍逐个析构
+struct Counted {
+	static int destoryed;
+	int value;
+
+	Counted(int v = 0) :value(v) {
+	}
+
+	~Counted() {
+		++destoryed;
+	}
+};
+
+int Counted::destoryed = 0;
+
+// 由PODs组成的聚合类型
+struct Record {
+	int id;
+	double weight;
+	const char *name;
+};
+
+void test_trivial() {
+	stl::Allocator<uint64_t> alloc;
+	uint64_t src[100];
+	for(int i = 0;i < 100;++i) {
+		src[i] = i * i;
+	}
+	uint64_t *dst = alloc.allocate(100);
+	stl::uninitialized_copy(src, src + 100, dst, alloc);
+	bool ok = true;
+	for(int i = 0;i < 100;++i) {
+		ok = ok && dst[i] == src[i];
+	}
+	stl::uninitialized_fill(dst, dst + 50, alloc);
+	stl::uninitialized_fill_n(uint64_t(7), dst + 50, 50, alloc);
+	for(int i = 0;i < 100;++i) {
+		ok = ok && dst[i] == (i < 50 ? 0 : 7);
+	}
+	stl::initialized_destory(dst, dst + 100, alloc);
+	alloc.deallocate(dst, 100);
+
+	char buf[16];
+	stl::uninitialized_fill_n('x', buf, 16, stl::Allocator<char>());
+	for(int i = 0;i < 16;++i) {
+		ok = ok && buf[i] == 'x';
+	}
+	std::cout << "trivial: " << (ok ? "ok" : "failed") << std::endl;
+}
+
+void test_non_trivial() {
+	{
+		stl::Vector<std::string> vec(10, std::string("tiny"));
+		stl::Vector<std::string> copy(vec);
+		copy.resize(20);
+		std::cout << "string: " << copy[9] << ' ' << copy[19].size() << std::endl;
+	}
+	{
+		stl::Vector<Counted> vec(10, Counted(1));
+		Counted::destoryed = 0;
+	}
+	std::cout << "destoryed: " << Counted::destoryed << std::endl;
+}
+
+void test_record() {
+	using traits = stl::type_traits<Record>;
+	std::cout << "Record traits: "
+		<< stl::tag_value<traits::has_trivial_default_constructor>::value
+		<< stl::tag_value<traits::has_trivial_copy_constructor>::value
+		<< stl::tag_value<traits::has_trivial_destructor>::value
+		<< stl::tag_value<traits::is_POD_type>::value
+		<< " Counted traits: "
+		<< stl::tag_value<stl::type_traits<Counted>::has_trivial_destructor>::value << std::endl;
+
+	stl::Vector<Record> vec(1000);
+	bool ok = true;
+	for(size_t i = 0;i < vec.size();++i) {
+		ok = ok && vec[i].id == 0 && vec[i].weight == 0 && vec[i].name == nullptr;
+		vec[i].id = static_cast<int>(i);
+	}
+	Record r = { 7, 1.5, "seven" };
+	vec.resize(2000, r);
+	stl::Vector<Record> copy(vec);
+	ok = ok && copy[999].id == 999 && copy[1999].id == 7 && copy[1999].name == r.name;
+	std::cout << "record: " << (ok ? "ok" : "failed") << std::endl;
+}
+
+void test_vector() {
+	const size_t n = 8 * 1024 * 1024;
+	auto start = std::chrono::steady_clock::now();
+	stl::Vector<uint64_t> vec(n, 1);
+	stl::Vector<uint64_t> copy(vec);
+	copy.resize(2 * n);
+	copy.clear();
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "vector<uint64_t>: " << vec.size() << ' ' << vec[n - 1] << std::endl;
+	std::cerr << "copy/resize/clear: "
+		<< std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+}
+
+int main() {
+	test_trivial();
+	test_non_trivial();
+	test_record();
+	test_vector();
+	return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef _TEST_UTIL_HPP__
+#define _TEST_UTIL_HPP__
+
+// 测试程序共用的辅助函数
+
+// 逐个元素与参照容器r比较
+template <typename C, typename R>
+bool same(const C &c, const R &r) {
+	if(c.size() != r.size()) {
+		return false;
+	}
+	auto q = r.begin();
+	for(auto p = c.begin();p != c.end();++p, ++q) {
+		if(*p != *q) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif // _TEST_UTIL_HPP__
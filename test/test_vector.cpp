@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "vector.hpp"
+#include "list.hpp"
 #include "algorithm.hpp"
 #include "numeric.hpp"
 
@@ -225,8 +226,42 @@ void main_test() {
 	std::cout << std::endl;
 }
 
+// 批量追加与不初始化的扩容
+void test_append() {
+	stl::Vector<int> vec;
+	int src[] = { 1, 2, 3, 4, 5 };
+	vec.append(src, src + 5);
+	stl::List<int> list;
+	for(int i = 6;i <= 10;++i) {
+		list.push_back(i);
+	}
+	vec.append(list.begin(), list.end());
+	vec.append(vec.begin(), vec.end());
+	std::cout << "append: " << vec.size();
+	for(int i : vec) {
+		std::cout << ' ' << i;
+	}
+	std::cout << std::endl;
+
+	stl::Vector<char> buf;
+	buf.resize_default_init(4096);
+	for(size_t i = 0;i < buf.size();++i) {
+		buf[i] = static_cast<char>('a' + i % 26);
+	}
+	buf.resize_default_init(26);
+	buf.resize_default_init(8192);
+	std::cout << "resize_default_init: " << buf.size() << ' ' << buf[25] << std::endl;
+
+	stl::Vector<Test> tests;
+	tests.resize_default_init(3);
+	tests.emplace_back(7);
+	tests.push_back(tests[3]);
+	test_show(tests);
+}
+
 int main() {
 	main_test();
 	Test::print_static();
+	test_append();
 	return 0;
 }
\ No newline at end of file